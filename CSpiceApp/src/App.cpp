@@ -9,11 +9,14 @@ App::~App()
 {
 	for(size_t i = 0; i < objects.size(); i++)
 	{
-		delete objects[i];
+		objects[i]->~SpaceObject();
 		objects[i] = nullptr;
 	}
 
 	objects.clear();
+	objectArena.Clear();
+	idIndex.clear();
+	nameIndex.clear();
 }
 
 void App::Init()
@@ -131,20 +134,24 @@ void App::LoadParent(const SpaceObject& child, bool includeMassCenter, bool incl
 	if(childId == parentId)
 		return;
 
-	if(SpaceObject::IsBody(parentId))
-		AddObject(SpaceBody(parentId));
-	else
-		AddObject(SpaceObject(parentId));
+	// Skip constructing objects which are already registered, construction costs CSpice lookups
+	if(!CheckObjectExists(parentId))
+	{
+		if(SpaceObject::IsBody(parentId))
+			AddObject(SpaceBody(parentId));
+		else
+			AddObject(SpaceObject(parentId));
+	}
 
 	if(includeMassCenter)
 	{
 		long massCenterId = SpaceObject::FindChildMassCenterId(parentId);
-		if(massCenterId != parentId)
+		if(massCenterId != parentId && !CheckObjectExists(massCenterId))
 			AddObject(SpaceBody(massCenterId));
 	}
 
 	if(recursive)
-		LoadParent(SpaceObject(parentId), includeMassCenter, false, true);
+		LoadParent(RetrieveObject(parentId), includeMassCenter, false, true);
 }
 
 void App::LoadMoons(const SpaceObject& planet)
@@ -200,7 +207,12 @@ void App::AddObject(const SpaceObject& obj)
 {
 	if(CheckObjectExists(obj) == false)
 	{
-		objects.push_back(obj.Clone());
+		size_t idx = objects.size();
+
+		objects.push_back(obj.CloneInto(objectArena));
+		idIndex[obj.GetSpiceId()] = idx;
+		nameIndex.insert(std::make_pair(obj.GetName(), idx));
+
 		LoadParent(obj, true, false, true);
 	}
 }
@@ -217,24 +229,16 @@ SpaceObject& App::GetObjectByIndex(size_t idx)
 
 bool App::CheckObjectExists(long id)
 {
-	for(size_t i = 0; i < objects.size(); i++)
-	{
-		if(objects[i]->GetSpiceId() == id)
-			return true;
-	}
+	size_t idx;
 
-	return false;
+	return FindObjectIndex(id, idx);
 }
 
 bool App::CheckObjectExists(const std::string& name)
 {
-	for(size_t i = 0; i < objects.size(); i++)
-	{
-		if(objects[i]->GetName() == name)
-			return true;
-	}
+	size_t idx;
 
-	return CheckObjectExists(SpaceObject(name));
+	return FindObjectIndex(name, idx);
 }
 
 bool App::CheckObjectExists(const SpaceObject& sample)
@@ -244,11 +248,10 @@ bool App::CheckObjectExists(const SpaceObject& sample)
 
 SpaceObject& App::RetrieveObject(long id)
 {
-	for(size_t i = 0; i < objects.size(); i++)
-	{
-		if(objects[i]->GetSpiceId() == id)
-			return GetObjectByIndex(i);
-	}
+	size_t idx;
+
+	if(FindObjectIndex(id, idx))
+		return GetObjectByIndex(idx);
 
 	CSpiceUtil::SignalError("RetrieveObject haven't found requested object");
 
@@ -257,13 +260,14 @@ SpaceObject& App::RetrieveObject(long id)
 
 SpaceObject& App::RetrieveObject(const std::string& name)
 {
-	for(size_t i = 0; i < objects.size(); i++)
-	{
-		if(objects[i]->GetName() == name)
-			return GetObjectByIndex(i);
-	}
+	size_t idx;
+
+	if(FindObjectIndex(name, idx))
+		return GetObjectByIndex(idx);
 
-	return RetrieveObject(SpaceObject(name));
+	CSpiceUtil::SignalError("RetrieveObject haven't found requested object");
+
+	throw;
 }
 
 SpaceObject& App::RetrieveObject(const SpaceObject& sample)
@@ -271,6 +275,41 @@ SpaceObject& App::RetrieveObject(const SpaceObject& sample)
 	return RetrieveObject(sample.GetSpiceId());
 }
 
+bool App::FindObjectIndex(long id, size_t& idx) const
+{
+	std::unordered_map<long, size_t>::const_iterator it = idIndex.find(id);
+
+	if(it == idIndex.end())
+		return false;
+
+	idx = it->second;
+
+	return true;
+}
+
+bool App::FindObjectIndex(const std::string& name, size_t& idx)
+{
+	std::unordered_map<std::string, size_t>::const_iterator it = nameIndex.find(name);
+
+	if(it != nameIndex.end())
+	{
+		idx = it->second;
+		return true;
+	}
+
+	long id;
+	if(!SpaceObject::TranslateName(name, id))
+		CSpiceUtil::SignalError("Cannot translate " + name + " into ID code");
+
+	if(!FindObjectIndex(id, idx))
+		return false;
+
+	// Remember CSpice names and aliases of loaded objects, so they are translated only once
+	nameIndex[name] = idx;
+
+	return true;
+}
+
 std::vector<SpaceObject*> App::GetLoadedPlanets()
 {
 	std::vector<SpaceObject*> planets;
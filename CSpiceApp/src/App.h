@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
@@ -76,7 +77,14 @@ public:
 	std::vector<SpaceObject*> GetLoadedBarycenters();
 
 private:
+	bool FindObjectIndex(long id, size_t& idx) const;
+	bool FindObjectIndex(const std::string& name, size_t& idx);
+
+private:
+	ObjectArena objectArena; // storage of all loaded objects, 'objects' holds raw pointers into it that stay valid only as long as the arena does
 	std::vector<SpaceObject*> objects;
+	std::unordered_map<long, size_t> idIndex;
+	std::unordered_map<std::string, size_t> nameIndex; // display names and already resolved CSpice names
 	Frame refFrame;
 
 	DefaultUnits units;
@@ -0,0 +1,93 @@
+#include "BinaryPck.h"
+#include "Frame.h"
+#include "../Math/Chebyshev.h"
+
+#include <cmath>
+
+bool BinaryPck::GetRotation(long classId, double et, Matrix3d& rotation)
+{
+	PckSegment* segment = index.Find(classId, et);
+
+	if(segment == nullptr || !IsNative(*segment))
+		return false;
+
+	EvaluateRotation(*segment, et, &rotation(0, 0), 1);
+
+	return true;
+}
+
+bool BinaryPck::GetRotations(long classId, const std::vector<double>& ets, std::vector<double>& rotations)
+{
+	size_t count = ets.size();
+	rotations.resize(9 * count);
+
+	for(size_t i = 0; i < count; i++)
+	{
+		// Looked up per epoch, a later loaded segment may take over inside the span of the previous one
+		PckSegment* segment = index.Find(classId, ets[i]);
+
+		if(segment == nullptr || !IsNative(*segment))
+			return false;
+
+		EvaluateRotation(*segment, ets[i], &rotations[i], count);
+	}
+
+	return true;
+}
+
+bool BinaryPck::HasData(long classId)
+{
+	return index.Has(classId);
+}
+
+void BinaryPck::Invalidate()
+{
+	index.Invalidate();
+}
+
+const std::unordered_map<long, std::vector<PckSegment>>& BinaryPck::GetSegments()
+{
+	return index.GetSegments();
+}
+
+bool BinaryPck::IsNative(const PckSegment& segment)
+{
+	return segment.type == PCK_TYPE_CHEBYSHEV_ANGLES && segment.refFrameId == J2000_FRAME_ID;
+}
+
+void BinaryPck::EvaluateRotation(PckSegment& segment, double et, double* rotation, size_t stride)
+{
+	const double* record = segment.GetRecord(et);
+	double mid = record[0];
+	double radius = record[1];
+	const double* coeffs = record + 2;
+
+	double s = (et - mid) / radius;
+	int count = (segment.recordSize - 2) / 3;
+
+	// Euler angles phi, delta, w in radians, the rotation is eul2m_c(w, delta, phi, 3, 1, 3)
+	double phi = ChebyshevValue(coeffs, count, s);
+	double delta = ChebyshevValue(coeffs + count, count, s);
+	double w = ChebyshevValue(coeffs + 2 * count, count, s);
+
+	double cp = std::cos(phi);
+	double sp = std::sin(phi);
+	double cd = std::cos(delta);
+	double sd = std::sin(delta);
+	double cw = std::cos(w);
+	double sw = std::sin(w);
+
+	rotation[0 * stride] = cw * cp - sw * cd * sp;
+	rotation[1 * stride] = cw * sp + sw * cd * cp;
+	rotation[2 * stride] = sw * sd;
+	rotation[3 * stride] = -sw * cp - cw * cd * sp;
+	rotation[4 * stride] = -sw * sp + cw * cd * cp;
+	rotation[5 * stride] = cw * sd;
+	rotation[6 * stride] = sd * sp;
+	rotation[7 * stride] = -sd * cp;
+	rotation[8 * stride] = cd;
+}
+
+static const long pckChebyshevTypes[] = { PCK_TYPE_CHEBYSHEV_ANGLES };
+
+DafSegmentIndex<PckSegment> BinaryPck::index("PCK", PCK_ND, PCK_NI, std::vector<long>(pckChebyshevTypes, pckChebyshevTypes + 1));
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CSpiceCore.h"
+#include "CSpiceUtil.h"
+#include "DafSegmentIndex.h"
+#include "../Math/Matrix3d.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#define PCK_ND 2
+#define PCK_NI 5
+
+#define PCK_TYPE_CHEBYSHEV_ANGLES 2
+
+struct PckSegment : public DafChebyshevSegment
+{
+public:
+	PckSegment() : classId(0), refFrameId(0)
+	{
+
+	}
+
+	void Unpack(const double* dc, const long* ic)
+	{
+		classId = ic[0];
+		refFrameId = ic[1];
+		type = ic[2];
+		start = dc[0];
+		stop = dc[1];
+		beginAddress = ic[3];
+		endAddress = ic[4];
+	}
+
+	long GetKey() const
+	{
+		return classId;
+	}
+
+public:
+	long classId;
+	long refFrameId;
+};
+
+// Evaluates type 2 binary PCK segments relative to J2000 natively, every other case is left to CSpice
+class BinaryPck
+{
+public:
+	// Rotation from J2000 to the body-fixed frame of a PCK frame class, false if no native segment covers et
+	static bool GetRotation(long classId, double et, Matrix3d& rotation);
+
+	// All or nothing, element (row, col) of rotation i at rotations[(3 * row + col) * ets.size() + i]
+	static bool GetRotations(long classId, const std::vector<double>& ets, std::vector<double>& rotations);
+
+	static bool HasData(long classId);
+	static void Invalidate();
+
+	// Descriptors of all loaded binary PCK segments by frame class, valid until the kernel set changes
+	static const std::unordered_map<long, std::vector<PckSegment>>& GetSegments();
+
+private:
+	static bool IsNative(const PckSegment& segment);
+	static void EvaluateRotation(PckSegment& segment, double et, double* rotation, size_t stride);
+
+private:
+	static DafSegmentIndex<PckSegment> index; // per frame class
+};
@@ -0,0 +1,147 @@
+#include "BodyCatalog.h"
+#include "SpaceObject.h"
+
+const BodyInfo& BodyCatalog::GetInfo(long id)
+{
+	EnsureBuilt();
+
+	std::unordered_map<long, BodyInfo>& bodies = GetBodies();
+	std::unordered_map<long, BodyInfo>::const_iterator it = bodies.find(id);
+
+	if(it != bodies.end())
+		return it->second;
+
+	return bodies.insert(std::make_pair(id, Describe(id))).first->second;
+}
+
+bool BodyCatalog::IsValid(long id)
+{
+	return GetInfo(id).valid;
+}
+
+bool BodyCatalog::HasFlags(long id, unsigned int flags)
+{
+	return (GetInfo(id).flags & flags) == flags;
+}
+
+const std::string& BodyCatalog::GetName(long id)
+{
+	return GetInfo(id).name;
+}
+
+long BodyCatalog::GetParentId(long id)
+{
+	return GetInfo(id).parentId;
+}
+
+const std::vector<long>& BodyCatalog::GetChildren(long id)
+{
+	return GetInfo(id).children;
+}
+
+void BodyCatalog::Invalidate()
+{
+	GetBodies().clear();
+	GetBuiltGeneration() = 0;
+}
+
+void BodyCatalog::EnsureBuilt()
+{
+	// Any kernel type may define body names, so the whole kernel set is watched
+	if(GetBuiltGeneration() != CSpiceUtil::GetKernelGeneration())
+		Build();
+}
+
+void BodyCatalog::Build()
+{
+	std::unordered_map<long, BodyInfo>& bodies = GetBodies();
+	bodies.clear();
+
+	for(long id = CATALOG_SSB_ID; id <= CATALOG_SUN_ID; id++)
+		bodies[id] = Describe(id);
+
+	for(long id = CATALOG_FIRST_SATELLITE_ID; id <= CATALOG_LAST_SATELLITE_ID; id++)
+		bodies[id] = Describe(id);
+
+	BodyInfo& ssb = bodies[CATALOG_SSB_ID];
+	for(long id = CATALOG_SSB_ID + 1; id <= CATALOG_SUN_ID; id++)
+	{
+		if(bodies[id].valid)
+			ssb.children.push_back(id);
+	}
+
+	for(long barycenterId = CATALOG_SSB_ID + 1; barycenterId < CATALOG_SUN_ID; barycenterId++)
+	{
+		BodyInfo& barycenter = bodies[barycenterId];
+		if(!barycenter.valid)
+			continue;
+
+		for(long i = 1; i <= CATALOG_MASS_CENTER_SUFFIX; i++)
+		{
+			long satelliteId = 100 * barycenterId + i;
+			if(bodies[satelliteId].valid)
+				barycenter.children.push_back(satelliteId);
+		}
+	}
+
+	GetBuiltGeneration() = CSpiceUtil::GetKernelGeneration();
+}
+
+BodyInfo BodyCatalog::Describe(long id)
+{
+	BodyInfo info;
+	info.id = id;
+	info.flags = 0;
+	info.parentId = id;
+
+	char objName[OBJECT_NAME_MAX_LENGTH];
+	SpiceBoolean found;
+	CSPICE_ASSERT(bodc2n_c(id, OBJECT_NAME_MAX_LENGTH, objName, &found));
+
+	info.valid = (found != SPICEFALSE);
+	if(!info.valid)
+		return info;
+
+	info.name = std::string(objName);
+
+	bool isSsb = (id == CATALOG_SSB_ID);
+	bool isSun = (id == CATALOG_SUN_ID);
+	bool isPlanetaryBarycenter = (id > CATALOG_SSB_ID && id < CATALOG_SUN_ID);
+	bool isSatelliteId = (id > 100 && id < 1000);
+	bool isPlanet = isSatelliteId && (id % 100) == CATALOG_MASS_CENTER_SUFFIX;
+
+	if(isSsb)
+		info.flags |= BF_SSB | BF_BARYCENTER;
+	if(isPlanetaryBarycenter)
+		info.flags |= BF_PLANETARY_BARYCENTER | BF_BARYCENTER;
+	if(isSun)
+		info.flags |= BF_SUN | BF_BODY;
+	if(isSatelliteId)
+		info.flags |= BF_BODY;
+	if(isPlanet)
+		info.flags |= BF_PLANET;
+	if(isSatelliteId && !isPlanet)
+		info.flags |= BF_MOON;
+
+	if(isSun || isPlanetaryBarycenter)
+		info.parentId = CATALOG_SSB_ID;
+	else if(isSatelliteId)
+		info.parentId = id / 100;
+
+	return info;
+}
+
+std::unordered_map<long, BodyInfo>& BodyCatalog::GetBodies()
+{
+	// Function scope statics, the catalog is already used while static SpaceObjects are constructed
+	static std::unordered_map<long, BodyInfo> bodies;
+
+	return bodies;
+}
+
+unsigned long& BodyCatalog::GetBuiltGeneration()
+{
+	static unsigned long builtGeneration = 0;
+
+	return builtGeneration;
+}
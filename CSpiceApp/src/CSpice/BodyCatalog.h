@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CSpiceCore.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#define CATALOG_SSB_ID 0
+#define CATALOG_SUN_ID 10
+#define CATALOG_FIRST_SATELLITE_ID 101
+#define CATALOG_LAST_SATELLITE_ID 999
+#define CATALOG_MASS_CENTER_SUFFIX 99
+
+enum BodyFlag
+{
+	BF_BARYCENTER = 1 << 0,
+	BF_PLANETARY_BARYCENTER = 1 << 1,
+	BF_SSB = 1 << 2,
+	BF_PLANET = 1 << 3,
+	BF_MOON = 1 << 4,
+	BF_BODY = 1 << 5,
+	BF_SUN = 1 << 6
+};
+
+struct BodyInfo
+{
+	long id;
+	bool valid;
+	std::string name; // CSpice name, empty for invalid IDs
+	unsigned int flags; // BodyFlag bits, never set for invalid IDs
+	long parentId;
+	std::vector<long> children; // in ascending order, including the mass center
+};
+
+// Valid NAIF IDs, names, parent/child tree and classification of bodies for the currently loaded kernel set.
+// Solar System IDs (0-10 and 100-999) are resolved when the catalog is built, other IDs on first request
+class BodyCatalog
+{
+public:
+	static const BodyInfo& GetInfo(long id);
+
+	static bool IsValid(long id);
+	static bool HasFlags(long id, unsigned int flags);
+	static const std::string& GetName(long id);
+	static long GetParentId(long id);
+	static const std::vector<long>& GetChildren(long id);
+
+	static void Invalidate();
+
+private:
+	static void EnsureBuilt();
+	static void Build();
+	static BodyInfo Describe(long id);
+
+	static std::unordered_map<long, BodyInfo>& GetBodies();
+	static unsigned long& GetBuiltGeneration();
+};
@@ -25,11 +25,36 @@ void CSpiceUtil::SetLoggingFile(const std::string& file)
 
 void CSpiceUtil::LoadKernel(const std::string& path)
 {
+	// Bumped up front, a failing meta-kernel may still have loaded some of its files
+	kernelGeneration++;
+
 	CSPICE_ASSERT(furnsh_c(path.c_str()));
 }
 
-std::vector<KernelData> CSpiceUtil::GetLoadedKernels(const std::string& type)
+void CSpiceUtil::UnloadKernel(const std::string& path)
+{
+	kernelGeneration++;
+
+	CSPICE_ASSERT(unload_c(path.c_str()));
+}
+
+unsigned long CSpiceUtil::GetKernelGeneration()
+{
+	return kernelGeneration;
+}
+
+const std::vector<KernelData>& CSpiceUtil::GetLoadedKernels(const std::string& type)
 {
+	if(inventoryGeneration != kernelGeneration)
+	{
+		inventory.clear();
+		inventoryGeneration = kernelGeneration;
+	}
+
+	std::map<std::string, std::vector<KernelData>>::const_iterator cached = inventory.find(type);
+	if(cached != inventory.end())
+		return cached->second;
+
 	long count;
 	CSPICE_ASSERT(ktotal_c(type.c_str(), &count));
 
@@ -50,11 +75,15 @@ std::vector<KernelData> CSpiceUtil::GetLoadedKernels(const std::string& type)
 		kernelData.filename = std::string(filename);
 		kernelData.type = std::string(filetype);
 		kernelData.source = std::string(source);
+		kernelData.handle = handle;
 
 		kernels.push_back(kernelData);
 	}
 
-	return kernels;
+	std::vector<KernelData>& stored = inventory[type];
+	stored.swap(kernels);
+
+	return stored;
 }
 
 std::string CSpiceUtil::GetShortErrorMessage()
@@ -185,3 +214,7 @@ std::vector<double> CSpiceUtil::DoubleCellToVector(SpiceCell cell)
 //}
 
 std::string CSpiceUtil::logFile = "";
+
+unsigned long CSpiceUtil::kernelGeneration = 1; // 0 is left for caches which were never built
+unsigned long CSpiceUtil::inventoryGeneration = 0;
+std::map<std::string, std::vector<KernelData>> CSpiceUtil::inventory;
@@ -8,6 +8,7 @@
 #include <fstream>
 #include <iomanip>
 #include <vector>
+#include <map>
 
 #define CSPICE_ASSERT(expression)																																					\
 	if(true)																																										\
@@ -42,6 +43,7 @@ struct KernelData
 	std::string filename;
 	std::string type;
 	std::string source;
+	long handle;
 };
 
 class CSpiceUtil
@@ -51,7 +53,11 @@ public:
 	static void SetLoggingFile(const std::string& file);
 
 	static void LoadKernel(const std::string& path);
-	static std::vector<KernelData> GetLoadedKernels(const std::string& type = "ALL");
+	static void UnloadKernel(const std::string& path);
+	static unsigned long GetKernelGeneration();
+
+	// Cached until the kernel set changes, the reference is invalidated by the next load or unload
+	static const std::vector<KernelData>& GetLoadedKernels(const std::string& type = "ALL");
 
 	static std::string GetShortErrorMessage();
 	static std::string GetExplainErrorMessage();
@@ -69,4 +75,8 @@ public:
 
 private:
 	static std::string logFile;
+
+	static unsigned long kernelGeneration; // bumped on every change of the loaded kernel set
+	static unsigned long inventoryGeneration;
+	static std::map<std::string, std::vector<KernelData>> inventory; // loaded kernels by requested type
 };
@@ -0,0 +1,88 @@
+#include "CoverageIndex.h"
+
+#include <algorithm>
+#include <utility>
+
+const BodyCoverage& CoverageIndex::GetCoverage(long id)
+{
+	EnsureBuilt();
+
+	std::unordered_map<long, BodyCoverage>::const_iterator it = coverages.find(id);
+
+	return (it != coverages.end()) ? it->second : empty;
+}
+
+bool CoverageIndex::IsCovered(long id, double et)
+{
+	return GetCoverage(id).window.IsIncluded(et);
+}
+
+std::vector<long> CoverageIndex::GetBodyIds()
+{
+	EnsureBuilt();
+
+	std::vector<long> ids;
+	ids.reserve(coverages.size());
+
+	for(std::unordered_map<long, BodyCoverage>::const_iterator it = coverages.begin(); it != coverages.end(); ++it)
+		ids.push_back(it->first);
+
+	std::sort(ids.begin(), ids.end());
+
+	return ids;
+}
+
+void CoverageIndex::EnsureBuilt()
+{
+	if(builtGeneration != CSpiceUtil::GetKernelGeneration())
+		Build();
+}
+
+void CoverageIndex::Build()
+{
+	coverages.clear();
+
+	const std::unordered_map<long, std::vector<SpkSegment>>& segments = Ephemeris::GetSegments();
+
+	for(std::unordered_map<long, std::vector<SpkSegment>>::const_iterator it = segments.begin(); it != segments.end(); ++it)
+	{
+		const std::vector<SpkSegment>& bodySegments = it->second;
+		BodyCoverage& coverage = coverages[it->first];
+
+		std::vector<std::pair<double, double>> intervals;
+		intervals.reserve(bodySegments.size());
+
+		for(size_t i = 0; i < bodySegments.size(); i++)
+		{
+			coverage.segments.push_back(&bodySegments[i]);
+			intervals.push_back(std::make_pair(bodySegments[i].start, bodySegments[i].stop));
+		}
+
+		std::sort(intervals.begin(), intervals.end());
+
+		// Overlapping and touching intervals are merged, the same way spkcov_c does
+		std::vector<double> endpoints;
+		endpoints.reserve(2 * intervals.size());
+
+		for(size_t i = 0; i < intervals.size(); i++)
+		{
+			if(!endpoints.empty() && intervals[i].first <= endpoints.back())
+			{
+				endpoints.back() = std::max(endpoints.back(), intervals[i].second);
+			}
+			else
+			{
+				endpoints.push_back(intervals[i].first);
+				endpoints.push_back(intervals[i].second);
+			}
+		}
+
+		coverage.window = Window(endpoints);
+	}
+
+	builtGeneration = CSpiceUtil::GetKernelGeneration();
+}
+
+std::unordered_map<long, BodyCoverage> CoverageIndex::coverages;
+unsigned long CoverageIndex::builtGeneration = 0;
+const BodyCoverage CoverageIndex::empty = BodyCoverage();
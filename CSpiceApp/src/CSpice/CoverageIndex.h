@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Ephemeris.h"
+#include "Window.h"
+
+#include <vector>
+#include <unordered_map>
+
+struct BodyCoverage
+{
+	Window window; // merged coverage intervals
+	std::vector<const SpkSegment*> segments; // contributing segments in load order
+};
+
+// SPK coverage of every body with loaded state data, built once per kernel set from the segment index
+class CoverageIndex
+{
+public:
+	static const BodyCoverage& GetCoverage(long id);
+	static bool IsCovered(long id, double et);
+	static std::vector<long> GetBodyIds();
+
+private:
+	static void EnsureBuilt();
+	static void Build();
+
+private:
+	static std::unordered_map<long, BodyCoverage> coverages;
+	static unsigned long builtGeneration;
+	static const BodyCoverage empty;
+};
@@ -0,0 +1,261 @@
+#include "DafFile.h"
+
+#include <cstring>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+DafFile::DafFile() : fileHandle(nullptr), mappingHandle(nullptr), view(nullptr), viewSize(0), nd(0), ni(0), forwardRecord(0)
+{
+
+}
+
+DafFile::~DafFile()
+{
+	Close();
+}
+
+bool DafFile::Open(const std::string& path)
+{
+	Close();
+
+	this->path = path;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE)
+		return false;
+
+	fileHandle = file;
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < DAF_RECORD_LENGTH || (unsigned long long)fileSize.QuadPart > (size_t)-1)
+	{
+		Close();
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(mapping == NULL)
+	{
+		Close();
+		return false;
+	}
+
+	mappingHandle = mapping;
+
+	view = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	viewSize = (size_t)fileSize.QuadPart;
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0)
+		return false;
+
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) != 0 || fileStat.st_size < DAF_RECORD_LENGTH)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* mapped = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if(mapped != MAP_FAILED)
+	{
+		view = (const char*)mapped;
+		viewSize = (size_t)fileStat.st_size;
+	}
+#endif
+
+	if(view == nullptr || !ParseFileRecord() || !ParseSummaries())
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void DafFile::Close()
+{
+#ifdef _WIN32
+	if(view != nullptr)
+		UnmapViewOfFile(view);
+	if(mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	if(fileHandle != nullptr)
+		CloseHandle(fileHandle);
+#else
+	if(view != nullptr)
+		munmap((void*)view, viewSize);
+#endif
+
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+	view = nullptr;
+	viewSize = 0;
+
+	nd = 0;
+	ni = 0;
+	forwardRecord = 0;
+
+	summaries.clear();
+	names.clear();
+}
+
+bool DafFile::IsOpen() const
+{
+	return view != nullptr;
+}
+
+const std::string& DafFile::GetPath() const
+{
+	return path;
+}
+
+const std::string& DafFile::GetIdWord() const
+{
+	return idWord;
+}
+
+long DafFile::GetND() const
+{
+	return nd;
+}
+
+long DafFile::GetNI() const
+{
+	return ni;
+}
+
+long DafFile::GetSummarySize() const
+{
+	return nd + (ni + 1) / 2;
+}
+
+size_t DafFile::GetSummaryCount() const
+{
+	return summaries.size();
+}
+
+const double* DafFile::GetSummary(size_t idx) const
+{
+	return summaries[idx];
+}
+
+void DafFile::UnpackSummary(size_t idx, double* dc, long* ic) const
+{
+	const double* summary = summaries[idx];
+
+	for(long i = 0; i < nd; i++)
+		dc[i] = summary[i];
+
+	// Integer components are packed two per double right after the double components
+	const int32_t* packed = (const int32_t*)(summary + nd);
+	for(long i = 0; i < ni; i++)
+		ic[i] = packed[i];
+}
+
+std::string DafFile::GetSegmentName(size_t idx) const
+{
+	size_t nameLength = 8 * GetSummarySize();
+
+	std::string name(names[idx], nameLength);
+	size_t last = name.find_last_not_of(' ');
+
+	return (last == std::string::npos) ? std::string() : name.substr(0, last + 1);
+}
+
+DafArray DafFile::GetArray(long beginAddress, long endAddress) const
+{
+	if(beginAddress < 1 || endAddress < beginAddress)
+		return DafArray();
+
+	size_t endOffset = (size_t)endAddress * sizeof(double);
+	if(endOffset > viewSize)
+		return DafArray();
+
+	const double* data = (const double*)view + (beginAddress - 1);
+
+	return DafArray(data, endAddress - beginAddress + 1);
+}
+
+bool DafFile::ParseFileRecord()
+{
+	idWord = std::string(view, DAF_ID_WORD_LENGTH);
+	if(idWord.compare(0, 4, "DAF/") != 0)
+		return false;
+
+	// Only the native binary format can be read in place
+	std::string format(view + 88, DAF_FORMAT_LENGTH);
+	if(format != DAF_NATIVE_FORMAT || !IsLittleEndianHost())
+		return false;
+
+	int32_t fileNd;
+	int32_t fileNi;
+	int32_t fileForward;
+
+	std::memcpy(&fileNd, view + 8, sizeof(int32_t));
+	std::memcpy(&fileNi, view + 12, sizeof(int32_t));
+	std::memcpy(&fileForward, view + 76, sizeof(int32_t));
+
+	if(fileNd < 0 || fileNi < 2 || fileNd + (fileNi + 1) / 2 > DAF_RECORD_DOUBLES - 3)
+		return false;
+
+	nd = fileNd;
+	ni = fileNi;
+	forwardRecord = fileForward;
+
+	return true;
+}
+
+bool DafFile::ParseSummaries()
+{
+	long summarySize = GetSummarySize();
+	size_t nameLength = 8 * summarySize;
+	size_t recordCount = viewSize / DAF_RECORD_LENGTH;
+
+	long record = forwardRecord;
+
+	// Summary records form a doubly linked list, each one is followed by its name record
+	for(size_t visited = 0; record != 0; visited++)
+	{
+		if(record < 1 || (size_t)record + 1 > recordCount || visited >= recordCount)
+			return false;
+
+		const char* recordStart = view + (size_t)(record - 1) * DAF_RECORD_LENGTH;
+		const double* controls = (const double*)recordStart;
+		const char* nameRecord = recordStart + DAF_RECORD_LENGTH;
+
+		long next = (long)controls[0];
+		long count = (long)controls[2];
+
+		if(count < 0 || count * summarySize > DAF_RECORD_DOUBLES - 3)
+			return false;
+
+		for(long i = 0; i < count; i++)
+		{
+			summaries.push_back(controls + 3 + i * summarySize);
+			names.push_back(nameRecord + i * nameLength);
+		}
+
+		record = next;
+	}
+
+	return true;
+}
+
+bool DafFile::IsLittleEndianHost()
+{
+	const uint16_t probe = 1;
+
+	return *(const uint8_t*)&probe == 1;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#define DAF_RECORD_LENGTH 1024
+#define DAF_RECORD_DOUBLES 128
+#define DAF_ID_WORD_LENGTH 8
+#define DAF_FORMAT_LENGTH 8
+#define DAF_NATIVE_FORMAT "LTL-IEEE"
+
+// Contiguous run of doubles inside a mapped file, no ownership
+struct DafArray
+{
+public:
+	DafArray() : data(nullptr), size(0)
+	{
+
+	}
+	DafArray(const double* data, size_t size) : data(data), size(size)
+	{
+
+	}
+
+	bool IsValid() const
+	{
+		return data != nullptr;
+	}
+
+public:
+	const double* data;
+	size_t size;
+};
+
+// Read-only memory mapped DAF (SPK, binary PCK, CK). Summaries, names and arrays are accessed in place.
+// Only files in the native binary format can be mapped, everything else has to go through CSpice.
+class DafFile
+{
+public:
+	DafFile();
+	~DafFile();
+
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const;
+	const std::string& GetPath() const;
+	const std::string& GetIdWord() const;
+
+	long GetND() const;
+	long GetNI() const;
+	long GetSummarySize() const;
+
+	size_t GetSummaryCount() const;
+	const double* GetSummary(size_t idx) const;
+	void UnpackSummary(size_t idx, double* dc, long* ic) const;
+	std::string GetSegmentName(size_t idx) const;
+
+	DafArray GetArray(long beginAddress, long endAddress) const;
+
+private:
+	DafFile(const DafFile&);
+	DafFile& operator=(const DafFile&);
+
+	bool ParseFileRecord();
+	bool ParseSummaries();
+
+	static bool IsLittleEndianHost();
+
+private:
+	std::string path;
+	std::string idWord;
+
+	void* fileHandle;
+	void* mappingHandle;
+	const char* view;
+	size_t viewSize;
+
+	long nd;
+	long ni;
+	long forwardRecord;
+
+	std::vector<const double*> summaries;
+	std::vector<const char*> names;
+};
@@ -0,0 +1,62 @@
+#include "DafSegmentIndex.h"
+
+#include <cmath>
+
+DafChebyshevSegment::DafChebyshevSegment() : type(0), start(0.0), stop(0.0), handle(0), beginAddress(0), endAddress(0),
+	initialEpoch(0.0), intervalLength(0.0), recordSize(0), recordCount(0), records(nullptr)
+{
+
+}
+
+bool DafChebyshevSegment::ReadDirectory(const DafFile& file)
+{
+	DafArray directory = file.GetArray(endAddress - DAF_CHEBYSHEV_DIRECTORY_SIZE + 1, endAddress);
+	if(!directory.IsValid())
+		return false;
+
+	initialEpoch = directory.data[0];
+	intervalLength = directory.data[1];
+	recordSize = (long)directory.data[2];
+	recordCount = (long)directory.data[3];
+
+	DafArray recordArray = file.GetArray(beginAddress, beginAddress + recordSize * recordCount - 1);
+	if(!recordArray.IsValid())
+		return false;
+
+	records = recordArray.data;
+
+	return true;
+}
+
+void DafChebyshevSegment::ReadDirectory()
+{
+	double directory[DAF_CHEBYSHEV_DIRECTORY_SIZE];
+	CSPICE_ASSERT(dafgda_c(handle, endAddress - DAF_CHEBYSHEV_DIRECTORY_SIZE + 1, endAddress, directory));
+
+	initialEpoch = directory[0];
+	intervalLength = directory[1];
+	recordSize = (long)directory[2];
+	recordCount = (long)directory[3];
+}
+
+const double* DafChebyshevSegment::GetRecord(double et)
+{
+	if(records == nullptr)
+	{
+		long size = recordSize * recordCount;
+
+		recordStorage.resize(size);
+
+		CSPICE_ASSERT(dafgda_c(handle, beginAddress, beginAddress + size - 1, &recordStorage[0]));
+
+		records = &recordStorage[0];
+	}
+
+	long recordIdx = (long)std::floor((et - initialEpoch) / intervalLength);
+	if(recordIdx < 0)
+		recordIdx = 0;
+	if(recordIdx >= recordCount)
+		recordIdx = recordCount - 1;
+
+	return &records[recordIdx * recordSize];
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "CSpiceCore.h"
+#include "CSpiceUtil.h"
+#include "DafFile.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#define DAF_CHEBYSHEV_DIRECTORY_SIZE 4 // INIT, INTLEN, RSIZE, N
+
+// Part of a segment descriptor shared by the DAF kernels with Chebyshev record segments (SPK types 2 and 3, binary PCK type 2)
+struct DafChebyshevSegment
+{
+public:
+	DafChebyshevSegment();
+
+	// Directory of a segment inside a mapped file, false if directory or records lie outside the mapping
+	bool ReadDirectory(const DafFile& file);
+	void ReadDirectory();
+
+	// Record covering et, the first or last one outside the segment epochs
+	const double* GetRecord(double et);
+
+public:
+	long type;
+	double start;
+	double stop;
+
+	long handle;
+	long beginAddress;
+	long endAddress;
+
+	double initialEpoch;
+	double intervalLength;
+	long recordSize;
+	long recordCount;
+
+	// Chebyshev records, either in place inside a mapped file or read through CSpice on first evaluation
+	const double* records;
+	std::vector<double> recordStorage;
+};
+
+// Segments of all loaded kernels of one type by the ID they are looked up with, rebuilt when the kernel set changes.
+// Segment derives from DafChebyshevSegment and provides Unpack(dc, ic), filling its own fields and the shared ones
+// from the summary, and GetKey(). Directories are only read for the given Chebyshev segment types.
+template<typename Segment>
+class DafSegmentIndex
+{
+public:
+	DafSegmentIndex(const std::string& kernelType, long nd, long ni, const std::vector<long>& chebyshevTypes);
+	~DafSegmentIndex();
+
+	// Later loaded files and later segments within a file take precedence
+	Segment* Find(long key, double et);
+	bool Has(long key);
+
+	void Invalidate();
+
+	// Valid until the kernel set changes
+	const std::unordered_map<long, std::vector<Segment>>& GetSegments();
+
+private:
+	DafSegmentIndex(const DafSegmentIndex&);
+	DafSegmentIndex& operator=(const DafSegmentIndex&);
+
+	void EnsureIndex();
+	void BuildIndex();
+	bool IndexMappedFile(const DafFile& file); // false if a segment lies outside the mapping
+	void IndexLoadedFile(long handle);
+	void ReleaseFiles();
+
+	bool IsChebyshev(long type) const;
+
+private:
+	std::string kernelType;
+	long nd;
+	long ni;
+	std::vector<long> chebyshevTypes;
+
+	std::unordered_map<long, std::vector<Segment>> segments; // per key, in load order
+	std::vector<DafFile*> files;
+	unsigned long indexedGeneration;
+};
+
+template<typename Segment>
+DafSegmentIndex<Segment>::DafSegmentIndex(const std::string& kernelType, long nd, long ni, const std::vector<long>& chebyshevTypes) :
+	kernelType(kernelType), nd(nd), ni(ni), chebyshevTypes(chebyshevTypes), indexedGeneration(0)
+{
+
+}
+
+template<typename Segment>
+DafSegmentIndex<Segment>::~DafSegmentIndex()
+{
+	ReleaseFiles();
+}
+
+template<typename Segment>
+Segment* DafSegmentIndex<Segment>::Find(long key, double et)
+{
+	EnsureIndex();
+
+	typename std::unordered_map<long, std::vector<Segment>>::iterator it = segments.find(key);
+
+	if(it == segments.end())
+		return nullptr;
+
+	std::vector<Segment>& keySegments = it->second;
+	for(size_t i = keySegments.size(); i > 0; i--)
+	{
+		Segment& segment = keySegments[i - 1];
+
+		if(et >= segment.start && et <= segment.stop)
+			return &segment;
+	}
+
+	return nullptr;
+}
+
+template<typename Segment>
+bool DafSegmentIndex<Segment>::Has(long key)
+{
+	EnsureIndex();
+
+	return segments.find(key) != segments.end();
+}
+
+template<typename Segment>
+void DafSegmentIndex<Segment>::Invalidate()
+{
+	segments.clear();
+	ReleaseFiles();
+	indexedGeneration = 0;
+}
+
+template<typename Segment>
+const std::unordered_map<long, std::vector<Segment>>& DafSegmentIndex<Segment>::GetSegments()
+{
+	EnsureIndex();
+
+	return segments;
+}
+
+template<typename Segment>
+void DafSegmentIndex<Segment>::EnsureIndex()
+{
+	if(indexedGeneration != CSpiceUtil::GetKernelGeneration())
+		BuildIndex();
+}
+
+template<typename Segment>
+void DafSegmentIndex<Segment>::BuildIndex()
+{
+	segments.clear();
+	ReleaseFiles();
+
+	const std::vector<KernelData>& kernels = CSpiceUtil::GetLoadedKernels(kernelType);
+
+	for(size_t i = 0; i < kernels.size(); i++)
+	{
+		DafFile* file = new DafFile();
+
+		// Files whose segments don't fit inside the mapping are left to CSpice, which reports real errors on read
+		if(file->Open(kernels[i].filename) && file->GetND() == nd && file->GetNI() == ni && IndexMappedFile(*file))
+		{
+			files.push_back(file);
+		}
+		else
+		{
+			delete file;
+			IndexLoadedFile(kernels[i].handle);
+		}
+	}
+
+	indexedGeneration = CSpiceUtil::GetKernelGeneration();
+}
+
+template<typename Segment>
+bool DafSegmentIndex<Segment>::IndexMappedFile(const DafFile& file)
+{
+	std::vector<Segment> fileSegments;
+
+	for(size_t i = 0; i < file.GetSummaryCount(); i++)
+	{
+		double dc[DAF_RECORD_DOUBLES];
+		long ic[2 * DAF_RECORD_DOUBLES];
+
+		file.UnpackSummary(i, dc, ic);
+
+		Segment segment;
+		segment.Unpack(dc, ic);
+
+		if(IsChebyshev(segment.type) && !segment.ReadDirectory(file))
+			return false;
+
+		fileSegments.push_back(segment);
+	}
+
+	for(size_t i = 0; i < fileSegments.size(); i++)
+		segments[fileSegments[i].GetKey()].push_back(fileSegments[i]);
+
+	return true;
+}
+
+template<typename Segment>
+void DafSegmentIndex<Segment>::IndexLoadedFile(long handle)
+{
+	SpiceBoolean found;
+
+	CSPICE_ASSERT(dafbfs_c(handle));
+	CSPICE_ASSERT(daffna_c(&found));
+
+	while(found != SPICEFALSE)
+	{
+		double summary[DAF_RECORD_DOUBLES];
+		double dc[DAF_RECORD_DOUBLES];
+		long ic[2 * DAF_RECORD_DOUBLES];
+
+		CSPICE_ASSERT(dafgs_c(summary));
+		CSPICE_ASSERT(dafus_c(summary, nd, ni, dc, ic));
+
+		Segment segment;
+		segment.Unpack(dc, ic);
+		segment.handle = handle;
+
+		if(IsChebyshev(segment.type))
+			segment.ReadDirectory();
+
+		segments[segment.GetKey()].push_back(segment);
+
+		CSPICE_ASSERT(daffna_c(&found));
+	}
+}
+
+template<typename Segment>
+void DafSegmentIndex<Segment>::ReleaseFiles()
+{
+	for(size_t i = 0; i < files.size(); i++)
+	{
+		delete files[i];
+		files[i] = nullptr;
+	}
+
+	files.clear();
+}
+
+template<typename Segment>
+bool DafSegmentIndex<Segment>::IsChebyshev(long type) const
+{
+	for(size_t i = 0; i < chebyshevTypes.size(); i++)
+	{
+		if(chebyshevTypes[i] == type)
+			return true;
+	}
+
+	return false;
+}
@@ -1,4 +1,5 @@
 #include "Date.h"
+#include "TimeConversion.h"
 
 Date::Date(double et)
 {
@@ -7,7 +8,7 @@ Date::Date(double et)
 
 Date::Date(std::string str)
 {
-	CSPICE_ASSERT(str2et_c(str.c_str(), &etTime));
+	etTime = TimeConversion::UtcToEt(str);
 }
 
 double Date::AsDouble() const
@@ -17,8 +18,14 @@ double Date::AsDouble() const
 
 std::string Date::AsString(const std::string& format) const
 {
-	char timeStr[FORMAT_STRING_BUFFER];
-	CSPICE_ASSERT(timout_c(etTime, format.c_str(), FORMAT_STRING_BUFFER, timeStr));
+	const DateFormat* cached = DateFormat::GetCached(format);
+	if(cached != nullptr)
+		return cached->Format(etTime);
 
-	return std::string(timeStr);
+	return DateFormat(format).Format(etTime);
+}
+
+size_t Date::AsString(const DateFormat& format, char* buffer, size_t size) const
+{
+	return format.Format(etTime, buffer, size);
 }
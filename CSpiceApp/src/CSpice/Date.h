@@ -3,9 +3,10 @@
 #include <string>
 
 #include "CSpiceCore.h"
+#include "DateFormat.h"
 #include "../Math/Quantity.h"
 
-#define FORMAT_STRING_BUFFER 1024
+#define DATE_DEFAULT_FORMAT "Mon DD YYYY HR:MN:SC (UTC+0) ::UTC+0"
 
 class Date
 {
@@ -14,7 +15,8 @@ public:
 	Date(std::string str);
 
 	double AsDouble() const;
-	std::string AsString(const std::string& format = "Mon DD YYYY HR:MN:SC (UTC+0) ::UTC+0") const;
+	std::string AsString(const std::string& format = DATE_DEFAULT_FORMAT) const;
+	size_t AsString(const DateFormat& format, char* buffer, size_t size) const;
 
 	Date operator+(double rhs) const
 	{
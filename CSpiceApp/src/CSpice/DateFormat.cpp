@@ -0,0 +1,418 @@
+#include "DateFormat.h"
+#include "TimeConversion.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+static const char* monthsUpper[12] = { "JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC" };
+static const char* monthsTitle[12] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+static const char* monthsLower[12] = { "jan", "feb", "mar", "apr", "may", "jun", "jul", "aug", "sep", "oct", "nov", "dec" };
+
+DateFormat::DateFormat(const std::string& picture) : picture(picture), native(false), fractionDigits(0), round(false), zoneOffset(0.0)
+{
+	native = Compile();
+
+	if(!native)
+		ops.clear();
+}
+
+const std::string& DateFormat::GetPicture() const
+{
+	return picture;
+}
+
+bool DateFormat::IsNative() const
+{
+	return native;
+}
+
+size_t DateFormat::GetMaxLength() const
+{
+	if(!native)
+		return FORMAT_STRING_BUFFER - 1;
+
+	size_t length = 0;
+
+	for(size_t i = 0; i < ops.size(); i++)
+	{
+		switch(ops[i].type)
+		{
+		case OT_LITERAL:
+			length += ops[i].literal.size();
+			break;
+		case OT_YEAR:
+			length += 6;
+			break;
+		case OT_SECOND:
+			length += 2 + (fractionDigits > 0 ? 1 + fractionDigits : 0);
+			break;
+		default:
+			length += 3;
+			break;
+		}
+	}
+
+	return length;
+}
+
+size_t DateFormat::Format(double et, char* buffer, size_t size) const
+{
+	if(size == 0)
+		return 0;
+
+	size_t length;
+	if(native && FormatNative(et, buffer, size, length))
+		return length;
+
+	CSPICE_ASSERT(timout_c(et, picture.c_str(), (SpiceInt)size, buffer));
+
+	return std::strlen(buffer);
+}
+
+std::string DateFormat::Format(double et) const
+{
+	char buffer[FORMAT_STRING_BUFFER];
+	size_t length = Format(et, buffer, FORMAT_STRING_BUFFER);
+
+	return std::string(buffer, length);
+}
+
+void DateFormat::Format(const double* ets, size_t count, char* buffer, size_t stride) const
+{
+	for(size_t i = 0; i < count; i++)
+		Format(ets[i], buffer + i * stride, stride);
+}
+
+void DateFormat::Format(const std::vector<double>& ets, char* buffer, size_t stride) const
+{
+	if(!ets.empty())
+		Format(&ets[0], ets.size(), buffer, stride);
+}
+
+const DateFormat* DateFormat::GetCached(const std::string& picture)
+{
+	std::map<std::string, DateFormat>::iterator it = formats.find(picture);
+
+	if(it != formats.end())
+		return &it->second;
+
+	if(formats.size() >= DATE_FORMAT_CACHE_SIZE)
+		return nullptr;
+
+	it = formats.insert(std::make_pair(picture, DateFormat(picture))).first;
+
+	return &it->second;
+}
+
+bool DateFormat::Compile()
+{
+	const char* p = picture.c_str();
+	std::string literal;
+
+	while(*p != '\0')
+	{
+		// Markers change how the epoch is converted and leave nothing in the output
+		if(std::strncmp(p, "::RND", 5) == 0)
+		{
+			round = true;
+			p += 5;
+			continue;
+		}
+		if(std::strncmp(p, "::TRNC", 6) == 0)
+		{
+			round = false;
+			p += 6;
+			continue;
+		}
+		if(std::strncmp(p, "::UTC", 5) == 0)
+		{
+			p += 5;
+
+			if(*p != '+' && *p != '-')
+				return false;
+
+			double sign = (*p++ == '-') ? -1.0 : 1.0;
+
+			int hours = 0;
+			int minutes = 0;
+			int digits = 0;
+
+			for(; *p >= '0' && *p <= '9' && digits < 2; p++, digits++)
+				hours = 10 * hours + (*p - '0');
+
+			if(digits == 0 || hours > 12)
+				return false;
+
+			if(*p == ':')
+			{
+				p++;
+
+				for(digits = 0; *p >= '0' && *p <= '9' && digits < 2; p++, digits++)
+					minutes = 10 * minutes + (*p - '0');
+
+				if(digits == 0 || minutes > 59)
+					return false;
+			}
+
+			zoneOffset = sign * (3600.0 * hours + 60.0 * minutes);
+			continue;
+		}
+		if(std::strncmp(p, "::", 2) == 0)
+			return false;
+
+		OpType type;
+		bool supported;
+		size_t tokenLength = MatchToken(p, type, supported);
+
+		if(tokenLength == 0)
+		{
+			if(*p == '.' && p[1] == '#')
+				return false;
+
+			literal += *p++;
+			continue;
+		}
+
+		if(!supported)
+			return false;
+
+		if(!literal.empty())
+		{
+			Op op = { OT_LITERAL, literal };
+			ops.push_back(op);
+			literal.clear();
+		}
+
+		Op op = { type, std::string() };
+		ops.push_back(op);
+		p += tokenLength;
+
+		// Only seconds take a fraction here, timout_c also allows it on other components
+		if(*p == '.' && p[1] == '#')
+		{
+			if(type != OT_SECOND)
+				return false;
+
+			p++;
+			for(fractionDigits = 0; *p == '#'; p++)
+				fractionDigits++;
+
+			if(fractionDigits > DATE_FORMAT_MAX_FRACTION_DIGITS)
+				return false;
+		}
+	}
+
+	// The CSpice wrapper returns strings without trailing blanks
+	size_t last = literal.find_last_not_of(' ');
+	literal = (last == std::string::npos) ? std::string() : literal.substr(0, last + 1);
+
+	if(!literal.empty())
+	{
+		Op op = { OT_LITERAL, literal };
+		ops.push_back(op);
+	}
+
+	return true;
+}
+
+static char* WriteNumber(char* out, long value, int width)
+{
+	for(int i = width - 1; i >= 0; i--)
+	{
+		out[i] = (char)('0' + value % 10);
+		value /= 10;
+	}
+
+	return out + width;
+}
+
+bool DateFormat::FormatNative(double et, char* buffer, size_t size, size_t& length) const
+{
+	double dayStart, timeOfDay, dayLength;
+	if(!TimeConversion::EtToUtc(et, dayStart, timeOfDay, dayLength))
+		return false;
+
+	if(zoneOffset != 0.0)
+	{
+		// Leap seconds in other zones are left to CSpice
+		if(timeOfDay >= SECONDS_PER_DAY)
+			return false;
+
+		timeOfDay += zoneOffset;
+		dayLength = SECONDS_PER_DAY;
+	}
+
+	// Truncate or round at the printed precision, then carry into the next day if needed
+	long long scale = 1;
+	for(int i = 0; i < fractionDigits; i++)
+		scale *= 10;
+
+	double scaled = timeOfDay * (double)scale;
+	long long ticks = (long long)std::floor(round ? scaled + 0.5 : scaled);
+
+	long days = (long)std::floor((dayStart + 0.5 * SECONDS_PER_DAY) / SECONDS_PER_DAY) + UNIX_DAYS_AT_J2000;
+
+	long long dayTicks = (long long)dayLength * scale;
+	while(ticks >= dayTicks)
+	{
+		ticks -= dayTicks;
+		days++;
+		dayTicks = (long long)SECONDS_PER_DAY * scale;
+	}
+	while(ticks < 0)
+	{
+		days--;
+		ticks += (long long)SECONDS_PER_DAY * scale;
+	}
+
+	long long wholeSeconds = ticks / scale;
+	long long fraction = ticks % scale;
+
+	int hour, minute, second;
+
+	if(wholeSeconds >= (long long)SECONDS_PER_DAY)
+	{
+		hour = 23;
+		minute = 59;
+		second = (int)(wholeSeconds - (long long)SECONDS_PER_DAY) + 60;
+	}
+	else
+	{
+		hour = (int)(wholeSeconds / 3600);
+		minute = (int)(wholeSeconds / 60 % 60);
+		second = (int)(wholeSeconds % 60);
+	}
+
+	int year, month, day;
+	TimeConversion::CivilFromDays(days, year, month, day);
+
+	if(year < 0 || year > 9999)
+		return false;
+
+	char text[FORMAT_STRING_BUFFER];
+	char* out = text;
+	char* end = text + FORMAT_STRING_BUFFER;
+
+	for(size_t i = 0; i < ops.size(); i++)
+	{
+		const Op& op = ops[i];
+
+		// Longest single op is a literal, every other one fits in 16 characters
+		if(op.type == OT_LITERAL ? (size_t)(end - out) <= op.literal.size() : end - out <= 16)
+			return false;
+
+		switch(op.type)
+		{
+		case OT_LITERAL:
+			std::memcpy(out, op.literal.data(), op.literal.size());
+			out += op.literal.size();
+			break;
+		case OT_YEAR:
+			out = WriteNumber(out, year, 4);
+			break;
+		case OT_MONTH_UPPER:
+			std::memcpy(out, monthsUpper[month - 1], 3);
+			out += 3;
+			break;
+		case OT_MONTH_TITLE:
+			std::memcpy(out, monthsTitle[month - 1], 3);
+			out += 3;
+			break;
+		case OT_MONTH_LOWER:
+			std::memcpy(out, monthsLower[month - 1], 3);
+			out += 3;
+			break;
+		case OT_MONTH:
+			out = WriteNumber(out, month, 2);
+			break;
+		case OT_DAY:
+			out = WriteNumber(out, day, 2);
+			break;
+		case OT_DAY_OF_YEAR:
+			out = WriteNumber(out, days - TimeConversion::DaysFromCivil(year, 1, 1) + 1, 3);
+			break;
+		case OT_HOUR:
+			out = WriteNumber(out, hour, 2);
+			break;
+		case OT_MINUTE:
+			out = WriteNumber(out, minute, 2);
+			break;
+		case OT_SECOND:
+			out = WriteNumber(out, second, 2);
+			if(fractionDigits > 0)
+			{
+				*out++ = '.';
+				out = WriteNumber(out, (long)fraction, fractionDigits);
+			}
+			break;
+		}
+	}
+
+	length = std::min((size_t)(out - text), size - 1);
+	std::memcpy(buffer, text, length);
+	buffer[length] = '\0';
+
+	return true;
+}
+
+size_t DateFormat::MatchToken(const char* p, OpType& type, bool& supported)
+{
+	struct Token
+	{
+		const char* text;
+		OpType type;
+		bool supported;
+	};
+
+	// Every timout_c marker, longest first as timout_c scans the picture, so unsupported ones send the picture to timout_c
+	static const Token tokens[] =
+	{
+		{ "WEEKDAY", OT_LITERAL, false },
+		{ "Weekday", OT_LITERAL, false },
+		{ "weekday", OT_LITERAL, false },
+		{ "JULIAND", OT_LITERAL, false },
+		{ "SP1950", OT_LITERAL, false },
+		{ "SP2000", OT_LITERAL, false },
+		{ "MONTH", OT_LITERAL, false },
+		{ "Month", OT_LITERAL, false },
+		{ "month", OT_LITERAL, false },
+		{ "YYYY", OT_YEAR, true },
+		{ "AMPM", OT_LITERAL, false },
+		{ "ampm", OT_LITERAL, false },
+		{ "MON", OT_MONTH_UPPER, true },
+		{ "Mon", OT_MONTH_TITLE, true },
+		{ "mon", OT_MONTH_LOWER, true },
+		{ "DOY", OT_DAY_OF_YEAR, true },
+		{ "WKD", OT_LITERAL, false },
+		{ "Wkd", OT_LITERAL, false },
+		{ "wkd", OT_LITERAL, false },
+		{ "ERA", OT_LITERAL, false },
+		{ "era", OT_LITERAL, false },
+		{ "YR", OT_LITERAL, false },
+		{ "MM", OT_MONTH, true },
+		{ "DD", OT_DAY, true },
+		{ "HR", OT_HOUR, true },
+		{ "MN", OT_MINUTE, true },
+		{ "SC", OT_SECOND, true },
+		{ "AP", OT_LITERAL, false },
+		{ "ap", OT_LITERAL, false }
+	};
+
+	for(size_t i = 0; i < sizeof(tokens) / sizeof(tokens[0]); i++)
+	{
+		size_t length = std::strlen(tokens[i].text);
+
+		if(std::strncmp(p, tokens[i].text, length) == 0)
+		{
+			type = tokens[i].type;
+			supported = tokens[i].supported;
+
+			return length;
+		}
+	}
+
+	return 0;
+}
+
+std::map<std::string, DateFormat> DateFormat::formats;
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CSpiceCore.h"
+#include "CSpiceUtil.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+#define FORMAT_STRING_BUFFER 1024
+#define DATE_FORMAT_MAX_FRACTION_DIGITS 9
+#define DATE_FORMAT_CACHE_SIZE 32
+
+// timout_c picture compiled once into a list of ops. YYYY, MON, Mon, mon, MM, DD, DOY, HR, MN, SC, SC.###,
+// ::UTC+h[:m], ::RND and ::TRNC are formatted natively. Pictures with any other timout_c marker
+// and epochs outside the leap second table go through timout_c.
+class DateFormat
+{
+public:
+	enum OpType
+	{
+		OT_LITERAL = 1,
+		OT_YEAR,
+		OT_MONTH_UPPER,
+		OT_MONTH_TITLE,
+		OT_MONTH_LOWER,
+		OT_MONTH,
+		OT_DAY,
+		OT_DAY_OF_YEAR,
+		OT_HOUR,
+		OT_MINUTE,
+		OT_SECOND
+	};
+
+	struct Op
+	{
+		OpType type;
+		std::string literal;
+	};
+
+public:
+	explicit DateFormat(const std::string& picture);
+
+	const std::string& GetPicture() const;
+	bool IsNative() const;
+	size_t GetMaxLength() const; // excluding the terminator
+
+	// Writes a null terminated string and returns its length, output longer than size - 1 is cut
+	size_t Format(double et, char* buffer, size_t size) const;
+	std::string Format(double et) const;
+
+	// String i at buffer + i * stride, stride should exceed GetMaxLength()
+	void Format(const double* ets, size_t count, char* buffer, size_t stride) const;
+	void Format(const std::vector<double>& ets, char* buffer, size_t stride) const;
+
+	// Compiled format of a picture, nullptr once DATE_FORMAT_CACHE_SIZE other pictures are cached.
+	// Hot paths should keep their own DateFormat instead.
+	static const DateFormat* GetCached(const std::string& picture);
+
+private:
+	bool Compile();
+	bool FormatNative(double et, char* buffer, size_t size, size_t& length) const;
+
+	static size_t MatchToken(const char* p, OpType& type, bool& supported);
+
+private:
+	std::string picture;
+	std::vector<Op> ops;
+	bool native;
+
+	int fractionDigits;
+	bool round;
+	double zoneOffset; // seconds
+
+	static std::map<std::string, DateFormat> formats;
+};
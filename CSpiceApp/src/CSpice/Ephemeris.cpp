@@ -0,0 +1,165 @@
+#include "Ephemeris.h"
+#include "SpaceObject.h"
+#include "../Math/Chebyshev.h"
+
+#include <cmath>
+
+void Ephemeris::GetState(long target, double et, const std::string& frameName, long observer, double state[6])
+{
+	if(nativeEnabled && GetNativeState(target, et, observer, state))
+	{
+		if(frameName != "J2000")
+		{
+			double j2000State[6];
+			double xform[6][6];
+
+			std::memcpy(j2000State, state, sizeof(j2000State));
+
+			CSPICE_ASSERT(sxform_c("J2000", frameName.c_str(), et, xform));
+			CSPICE_ASSERT(mxvg_c(xform, j2000State, 6, 6, state));
+		}
+
+		return;
+	}
+
+	double lt;
+	CSPICE_ASSERT(spkgeo_c(target, et, frameName.c_str(), observer, state, &lt));
+}
+
+bool Ephemeris::GetNativeState(long target, double et, long observer, double state[6])
+{
+	// State of the target relative to each node of its center chain up to SSB
+	long chainIds[SPK_MAX_CHAIN_LENGTH];
+	double chainStates[SPK_MAX_CHAIN_LENGTH][6];
+
+	chainIds[0] = target;
+	for(int i = 0; i < 6; i++)
+		chainStates[0][i] = 0.0;
+
+	long chainLength = 1;
+	long body = target;
+
+	while(body != SSB_SPICE_ID)
+	{
+		if(chainLength == SPK_MAX_CHAIN_LENGTH)
+			return false;
+
+		double segmentState[6];
+		long center;
+
+		if(!EvaluateBody(body, et, segmentState, center))
+			return false;
+
+		for(int i = 0; i < 6; i++)
+			chainStates[chainLength][i] = chainStates[chainLength - 1][i] + segmentState[i];
+
+		chainIds[chainLength] = center;
+		chainLength++;
+
+		body = center;
+	}
+
+	// Walk up from the observer until its chain meets the target one
+	double observerState[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	body = observer;
+
+	for(long depth = 0; depth < SPK_MAX_CHAIN_LENGTH; depth++)
+	{
+		for(long node = 0; node < chainLength; node++)
+		{
+			if(chainIds[node] == body)
+			{
+				for(int i = 0; i < 6; i++)
+					state[i] = chainStates[node][i] - observerState[i];
+
+				return true;
+			}
+		}
+
+		double segmentState[6];
+		long center;
+
+		if(!EvaluateBody(body, et, segmentState, center))
+			return false;
+
+		for(int i = 0; i < 6; i++)
+			observerState[i] += segmentState[i];
+
+		body = center;
+	}
+
+	return false;
+}
+
+void Ephemeris::SetNativeEvaluation(bool enabled)
+{
+	nativeEnabled = enabled;
+}
+
+bool Ephemeris::IsNativeEvaluationEnabled()
+{
+	return nativeEnabled;
+}
+
+void Ephemeris::Invalidate()
+{
+	index.Invalidate();
+}
+
+const std::unordered_map<long, std::vector<SpkSegment>>& Ephemeris::GetSegments()
+{
+	return index.GetSegments();
+}
+
+bool Ephemeris::EvaluateBody(long body, double et, double state[6], long& center)
+{
+	SpkSegment* segment = index.Find(body, et);
+
+	if(segment == nullptr)
+		return false;
+
+	if(segment->type != SPK_TYPE_CHEBYSHEV_POSITION && segment->type != SPK_TYPE_CHEBYSHEV_STATE)
+		return false;
+
+	if(segment->frameId != J2000_FRAME_ID)
+		return false;
+
+	EvaluateSegment(*segment, et, state);
+	center = segment->center;
+
+	return true;
+}
+
+void Ephemeris::EvaluateSegment(SpkSegment& segment, double et, double state[6])
+{
+	const double* record = segment.GetRecord(et);
+	double mid = record[0];
+	double radius = record[1];
+	const double* coeffs = record + 2;
+
+	double s = (et - mid) / radius;
+
+	if(segment.type == SPK_TYPE_CHEBYSHEV_POSITION)
+	{
+		int count = (segment.recordSize - 2) / 3;
+
+		for(int i = 0; i < 3; i++)
+		{
+			double derivative;
+			ChebyshevValueDerivative(coeffs + i * count, count, s, state[i], derivative);
+			state[i + 3] = derivative / radius;
+		}
+	}
+	else
+	{
+		int count = (segment.recordSize - 2) / 6;
+
+		for(int i = 0; i < 6; i++)
+			state[i] = ChebyshevValue(coeffs + i * count, count, s);
+	}
+}
+
+static const long spkChebyshevTypes[] = { SPK_TYPE_CHEBYSHEV_POSITION, SPK_TYPE_CHEBYSHEV_STATE };
+
+DafSegmentIndex<SpkSegment> Ephemeris::index("SPK", SPK_ND, SPK_NI, std::vector<long>(spkChebyshevTypes, spkChebyshevTypes + 2));
+bool Ephemeris::nativeEnabled = true;
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CSpiceCore.h"
+#include "CSpiceUtil.h"
+#include "DafSegmentIndex.h"
+#include "Frame.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#define SPK_ND 2
+#define SPK_NI 6
+
+#define SPK_TYPE_CHEBYSHEV_POSITION 2
+#define SPK_TYPE_CHEBYSHEV_STATE 3
+
+#define SPK_MAX_CHAIN_LENGTH 32
+
+struct SpkSegment : public DafChebyshevSegment
+{
+public:
+	SpkSegment() : target(0), center(0), frameId(0)
+	{
+
+	}
+
+	void Unpack(const double* dc, const long* ic)
+	{
+		target = ic[0];
+		center = ic[1];
+		frameId = ic[2];
+		type = ic[3];
+		start = dc[0];
+		stop = dc[1];
+		beginAddress = ic[4];
+		endAddress = ic[5];
+	}
+
+	long GetKey() const
+	{
+		return target;
+	}
+
+public:
+	long target;
+	long center;
+	long frameId;
+};
+
+// Evaluates type 2 and 3 SPK segments natively, every other case is delegated to CSpice
+class Ephemeris
+{
+public:
+	static void GetState(long target, double et, const std::string& frameName, long observer, double state[6]);
+	static bool GetNativeState(long target, double et, long observer, double state[6]);
+
+	static void SetNativeEvaluation(bool enabled);
+	static bool IsNativeEvaluationEnabled();
+
+	static void Invalidate();
+
+	// Descriptors of all loaded SPK segments by body, valid until the kernel set changes
+	static const std::unordered_map<long, std::vector<SpkSegment>>& GetSegments();
+
+private:
+	static bool EvaluateBody(long body, double et, double state[6], long& center);
+	static void EvaluateSegment(SpkSegment& segment, double et, double state[6]);
+
+private:
+	static DafSegmentIndex<SpkSegment> index; // per body
+	static bool nativeEnabled;
+};
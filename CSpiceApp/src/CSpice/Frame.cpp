@@ -1,4 +1,11 @@
 #include "Frame.h"
+#include "RotationCache.h"
+#include "IauRotationModel.h"
+#include "BinaryPck.h"
+#include "StateArray.h"
+#include "../Math/VectorRotation.h"
+
+#include <algorithm>
 
 const Frame Frame::J2000 = Frame("J2000");
 const Frame Frame::ECLIPJ2000 = Frame("ECLIPJ2000");
@@ -18,19 +25,121 @@ Frame::Frame(const std::string& spiceName, const std::string& name)
 
 void Frame::Construct(int spiceId, const std::string& name)
 {
-	if(!ValidateId(spiceId))
+	SpiceInt centerId;
+	SpiceInt clssid;
+	SpiceInt frclss;
+	SpiceBoolean found;
+	CSPICE_ASSERT(frinfo_c(spiceId, &centerId, &frclss, &clssid, &found));
+
+	if(found == SPICEFALSE)
 		CSpiceUtil::SignalError("No such CSpice frame is defined");
 
 	this->spiceId = spiceId;
 
+	char frameName[FRAME_NAME_MAX_LENGTH];
+	CSPICE_ASSERT( frmnam_c(spiceId, FRAME_NAME_MAX_LENGTH, frameName) );
+	this->spiceName = std::string(frameName);
+
+	this->info.centerId = centerId;
+	this->info.classId = clssid;
+	this->info.frameType = FrameType(frclss);
+
 	if(name != "")
 	{
 		this->name = name;
 	}
 	else
 	{
-		this->name = GetSpiceName();
+		this->name = this->spiceName;
+	}
+
+	ResolveAnchor();
+}
+
+void Frame::UpdateAnchor() const
+{
+	if(anchorGeneration != CSpiceUtil::GetKernelGeneration())
+		ResolveAnchor();
+}
+
+void Frame::ResolveAnchor() const
+{
+	anchor.rotation = Matrix3d::Identity();
+
+	long currentId = spiceId;
+	std::string currentName = spiceName;
+	FrameType currentType = info.frameType;
+	long currentClassId = info.classId;
+
+	// Fold constant links into anchor.rotation until J2000 or a time dependent frame is reached
+	for(int depth = 0; depth < FRAME_MAX_CHAIN_LENGTH && currentId != J2000_FRAME_ID; depth++)
+	{
+		std::string parentName;
+
+		if(currentType == FT_INERTIAL)
+		{
+			parentName = "J2000";
+		}
+		else if(currentType != FT_TK || !FindTkParent(currentId, currentName, parentName))
+		{
+			break;
+		}
+
+		long parentId;
+		CSPICE_ASSERT(namfrm_c(parentName.c_str(), &parentId));
+
+		SpiceInt centerId;
+		SpiceInt clssid;
+		SpiceInt frclss;
+		SpiceBoolean found;
+		CSPICE_ASSERT(frinfo_c(parentId, &centerId, &frclss, &clssid, &found));
+
+		if(found == SPICEFALSE)
+			break;
+
+		// Both kinds of links are time invariant, so any epoch does
+		Matrix3d link;
+		CSPICE_ASSERT(pxform_c(currentName.c_str(), parentName.c_str(), 0.0, link.GetData()));
+		anchor.rotation = link * anchor.rotation;
+
+		char frameName[FRAME_NAME_MAX_LENGTH];
+		CSPICE_ASSERT(frmnam_c(parentId, FRAME_NAME_MAX_LENGTH, frameName));
+
+		currentId = parentId;
+		currentName = std::string(frameName);
+		currentType = FrameType(frclss);
+		currentClassId = clssid;
+	}
+
+	anchor.id = currentId;
+	anchor.name = currentName;
+	anchor.type = currentType;
+	anchor.classId = currentClassId;
+
+	anchorGeneration = CSpiceUtil::GetKernelGeneration();
+}
+
+bool Frame::FindTkParent(long id, const std::string& spiceName, std::string& parentName)
+{
+	// TK frames name their parent either by frame ID or by frame name
+	std::string keys[2] = { "TKFRAME_" + std::to_string(id) + "_RELATIVE", "TKFRAME_" + spiceName + "_RELATIVE" };
+
+	for(int i = 0; i < 2; i++)
+	{
+		char value[FRAME_NAME_MAX_LENGTH];
+		SpiceInt count;
+		SpiceBoolean found;
+
+		CSPICE_ASSERT(gcpool_c(keys[i].c_str(), 0, 1, FRAME_NAME_MAX_LENGTH, &count, value, &found));
+
+		if(found != SPICEFALSE && count > 0)
+		{
+			parentName = std::string(value);
+			return true;
+		}
 	}
+
+	return false;
 }
 
 Frame::~Frame()
@@ -43,12 +152,9 @@ long Frame::GetSpiceId() const
 	return spiceId;
 }
 
-std::string Frame::GetSpiceName() const
+const std::string& Frame::GetSpiceName() const
 {
-	char frameName[FRAME_NAME_MAX_LENGTH];
-	CSPICE_ASSERT( frmnam_c(spiceId, FRAME_NAME_MAX_LENGTH, frameName) );
-
-	return std::string(frameName);
+	return spiceName;
 }
 
 const std::string& Frame::GetName() const
@@ -56,70 +162,357 @@ const std::string& Frame::GetName() const
 	return name;
 }
 
-Frame::FrameInfo Frame::GetFrameInfo() const
+const Frame::FrameInfo& Frame::GetFrameInfo() const
 {
-	SpiceInt centerId;
-	SpiceInt clssid;
-	SpiceInt frclss;
-	SpiceBoolean found;
+	return info;
+}
 
-	CSPICE_ASSERT(frinfo_c(spiceId, &centerId, &frclss, &clssid, &found));
+long Frame::GetCenterId() const
+{
+	return info.centerId;
+}
+
+Matrix3d Frame::GetRotation(const Date& t, const Frame& ref) const
+{
+	Matrix3d rotation;
+	if(GetConstantRotation(ref, rotation))
+		return rotation;
+
+	// Only the link between the two anchors depends on time
+	double et = t.AsDouble();
+	Matrix3d anchorLink;
+
+	if(!RotationCache::Find(anchor.id, ref.anchor.id, et, anchorLink))
+	{
+		EvaluateAnchorLink(ref, et, anchorLink);
+		RotationCache::Store(anchor.id, ref.anchor.id, et, anchorLink);
+	}
+
+	return ref.anchor.rotation.TransposeMultiply(anchorLink * anchor.rotation);
+}
+
+bool Frame::GetConstantRotation(const Frame& ref, Matrix3d& rotation) const
+{
+	UpdateAnchor();
+	ref.UpdateAnchor();
 
-	FrameInfo finfo;
-	finfo.centerId = centerId;
-	finfo.classId = clssid;
-	finfo.frameType = FrameType(frclss);
+	if(anchor.id != ref.anchor.id)
+		return false;
 
-	return finfo;
+	rotation = ref.anchor.rotation.TransposeMultiply(anchor.rotation);
+
+	return true;
 }
 
-Vector3 Frame::TransformVector(const Vector3& vec, const Date& t, const Frame& ref) const
+void Frame::GetRotations(const std::vector<double>& ets, const Frame& ref, std::vector<double>& rotations) const
 {
-	double transform[3][3];
+	size_t count = ets.size();
+	rotations.resize(9 * count);
 
-	CSPICE_ASSERT(pxform_c(GetSpiceName().c_str(), ref.GetSpiceName().c_str(), t.AsDouble(), transform));
+	Matrix3d rotation;
+	bool constant = GetConstantRotation(ref, rotation);
 
-	double axisLocal[3] = {vec.x, vec.y, vec.z};
-	double axisGlobal[3];
+	// Anchors with native orientation data are evaluated for the whole batch at once
+	std::vector<double> fromRotations;
+	std::vector<double> toRotations;
 
-	CSPICE_ASSERT(mxv_c(transform, axisLocal, axisGlobal));
+	bool native = !constant && GetAnchorRotations(ets, fromRotations) && ref.GetAnchorRotations(ets, toRotations);
 
-	return Vector3(axisGlobal);
+	// Batches bypass the rotation cache, only runs of equal epochs share an evaluation
+	for(size_t i = 0; i < count; i++)
+	{
+		if(!constant && (i == 0 || ets[i] != ets[i - 1]))
+		{
+			Matrix3d anchorLink;
+
+			if(native)
+			{
+				Matrix3d fromRotation = Matrix3d::Identity();
+				Matrix3d toRotation = Matrix3d::Identity();
+
+				for(int k = 0; k < 9; k++)
+				{
+					if(!fromRotations.empty())
+						fromRotation(k / 3, k % 3) = fromRotations[k * count + i];
+					if(!toRotations.empty())
+						toRotation(k / 3, k % 3) = toRotations[k * count + i];
+				}
+
+				anchorLink = toRotation * fromRotation.Transposed();
+			}
+			else
+			{
+				CSPICE_ASSERT(pxform_c(anchor.name.c_str(), ref.anchor.name.c_str(), ets[i], anchorLink.GetData()));
+			}
+
+			rotation = ref.anchor.rotation.TransposeMultiply(anchorLink * anchor.rotation);
+		}
+
+		for(int k = 0; k < 9; k++)
+			rotations[k * count + i] = rotation(k / 3, k % 3);
+	}
 }
 
-Vector3 Frame::AxisX(const Date& t, const Frame& ref) const
+void Frame::GetStateTransformation(const Date& t, const Frame& ref, double transform[6][6]) const
 {
-	return TransformVector(Vector3::i, t, ref);
+	Matrix3d rotation;
+
+	if(GetConstantRotation(ref, rotation))
+	{
+		for(int row = 0; row < 6; row++)
+		{
+			for(int col = 0; col < 6; col++)
+				transform[row][col] = (row / 3 == col / 3) ? rotation(row % 3, col % 3) : 0.0;
+		}
+
+		return;
+	}
+
+	double anchorTransform[6][6];
+	CSPICE_ASSERT(sxform_c(anchor.name.c_str(), ref.anchor.name.c_str(), t.AsDouble(), anchorTransform));
+
+	ComposeStateTransformation(ref, anchorTransform, &transform[0][0]);
 }
 
-Vector3 Frame::AxisY(const Date& t, const Frame& ref) const
+void Frame::GetStateTransformations(const std::vector<double>& ets, const Frame& ref, std::vector<double>& transforms) const
 {
-	return TransformVector(Vector3::j, t, ref);
+	size_t count = ets.size();
+	transforms.resize(36 * count);
+
+	if(count == 0)
+		return;
+
+	Matrix3d rotation;
+	bool constant = GetConstantRotation(ref, rotation);
+
+	for(size_t i = 0; i < count; i++)
+	{
+		double* transform = &transforms[36 * i];
+
+		if(i > 0 && (constant || ets[i] == ets[i - 1]))
+		{
+			std::copy(transform - 36, transform, transform);
+			continue;
+		}
+
+		if(constant)
+		{
+			for(int row = 0; row < 6; row++)
+			{
+				for(int col = 0; col < 6; col++)
+					transform[6 * row + col] = (row / 3 == col / 3) ? rotation(row % 3, col % 3) : 0.0;
+			}
+
+			continue;
+		}
+
+		double anchorTransform[6][6];
+		CSPICE_ASSERT(sxform_c(anchor.name.c_str(), ref.anchor.name.c_str(), ets[i], anchorTransform));
+
+		ComposeStateTransformation(ref, anchorTransform, transform);
+	}
 }
 
-Vector3 Frame::AxisZ(const Date& t, const Frame& ref) const
+void Frame::TransformStates(const std::vector<double>& ets, const Frame& ref, StateArray& states) const
 {
-	return TransformVector(Vector3::k, t, ref);
+	if(states.Size() != ets.size())
+		CSpiceUtil::SignalError("Frame::TransformStates: state and epoch counts differ");
+
+	Matrix3d rotation;
+
+	if(GetConstantRotation(ref, rotation))
+	{
+		states.Rotate(rotation);
+		return;
+	}
+
+	std::vector<double> transforms;
+	GetStateTransformations(ets, ref, transforms);
+
+	// Base units of position and velocity share the length unit, so the rate block applies unchanged
+	double* px = states.position.x.Data();
+	double* py = states.position.y.Data();
+	double* pz = states.position.z.Data();
+	double* vx = states.velocity.x.Data();
+	double* vy = states.velocity.y.Data();
+	double* vz = states.velocity.z.Data();
+
+	for(size_t i = 0; i < ets.size(); i++)
+	{
+		const double* m = &transforms[36 * i];
+
+		double state[6] = { px[i], py[i], pz[i], vx[i], vy[i], vz[i] };
+		double out[6];
+
+		// Upper right block is zero, position doesn't depend on velocity
+		for(int row = 0; row < 3; row++)
+			out[row] = m[6 * row] * state[0] + m[6 * row + 1] * state[1] + m[6 * row + 2] * state[2];
+
+		for(int row = 3; row < 6; row++)
+		{
+			const double* r = m + 6 * row;
+			out[row] = r[0] * state[0] + r[1] * state[1] + r[2] * state[2] + r[3] * state[3] + r[4] * state[4] + r[5] * state[5];
+		}
+
+		px[i] = out[0];
+		py[i] = out[1];
+		pz[i] = out[2];
+		vx[i] = out[3];
+		vy[i] = out[4];
+		vz[i] = out[5];
+	}
 }
 
-Matrix4x4 Frame::GetTransformationMatrix(const Date& t, const Frame& ref) const
+bool Frame::GetAnchorRotation(double et, Matrix3d& rotation) const
+{
+	if(anchor.id == J2000_FRAME_ID)
+	{
+		rotation = Matrix3d::Identity();
+		return true;
+	}
+
+	if(anchor.type != FT_PCK)
+		return false;
+
+	// Binary PCK data takes precedence over text constants, epochs it doesn't cover are left to CSpice
+	if(BinaryPck::HasData(anchor.classId))
+		return BinaryPck::GetRotation(anchor.classId, et, rotation);
+
+	const IauRotationModel* model = IauRotationModel::Find(anchor.classId);
+	if(model == nullptr)
+		return false;
+
+	model->GetRotation(et, rotation);
+
+	return true;
+}
+
+bool Frame::GetAnchorRotations(const std::vector<double>& ets, std::vector<double>& rotations) const
 {
-	Matrix4x4 transform = Matrix4x4::Zero;
+	if(anchor.id == J2000_FRAME_ID)
+	{
+		rotations.clear();
+		return true;
+	}
+
+	if(anchor.type != FT_PCK)
+		return false;
+
+	if(BinaryPck::HasData(anchor.classId))
+		return BinaryPck::GetRotations(anchor.classId, ets, rotations);
+
+	const IauRotationModel* model = IauRotationModel::Find(anchor.classId);
+	if(model == nullptr)
+		return false;
+
+	model->GetRotations(ets, rotations);
 
-	Vector3 x = AxisX(t, ref);
-	Vector3 y = AxisY(t, ref);
-	Vector3 z = AxisZ(t, ref);
+	return true;
+}
+
+void Frame::EvaluateAnchorLink(const Frame& ref, double et, Matrix3d& link) const
+{
+	Matrix3d fromRotation;
+	Matrix3d toRotation;
 
-	for(int row = 0; row < 3; row++)
+	if(!GetAnchorRotation(et, fromRotation) || !ref.GetAnchorRotation(et, toRotation))
 	{
-		transform.Set(row, 0, x[row]);
-		transform.Set(row, 1, y[row]);
-		transform.Set(row, 2, z[row]);
+		CSPICE_ASSERT(pxform_c(anchor.name.c_str(), ref.anchor.name.c_str(), et, link.GetData()));
+		return;
 	}
 
-	transform.Set(3, 3, 1.0);
+	// J2000 -> ref anchor after anchor -> J2000
+	link = toRotation * fromRotation.Transposed();
+}
 
-	return transform;
+void Frame::ComposeStateTransformation(const Frame& ref, const double anchorTransform[6][6], double* transform) const
+{
+	// Constant links don't contribute to the derivative block, so both blocks get the same outer rotations
+	for(int block = 0; block < 2; block++)
+	{
+		Matrix3d anchorBlock;
+		for(int row = 0; row < 3; row++)
+		{
+			for(int col = 0; col < 3; col++)
+				anchorBlock(row, col) = anchorTransform[3 * block + row][col];
+		}
+
+		Matrix3d composed = ref.anchor.rotation.TransposeMultiply(anchorBlock * anchor.rotation);
+
+		for(int row = 0; row < 3; row++)
+		{
+			for(int col = 0; col < 3; col++)
+			{
+				transform[6 * (3 * block + row) + col] = composed(row, col);
+				transform[6 * (3 * block + row) + col + 3] = (block == 0) ? 0.0 : transform[6 * row + col];
+			}
+		}
+	}
+}
+
+bool Frame::IsInertial() const
+{
+	UpdateAnchor();
+
+	return anchor.id == J2000_FRAME_ID;
+}
+
+Vector3d Frame::TransformVector(const Vector3d& vec, const Date& t, const Frame& ref) const
+{
+	return GetRotation(t, ref) * vec;
+}
+
+void Frame::TransformVectors(const Vec3Array& vectors, const Date& t, const Frame& ref, Vec3Array& out) const
+{
+	Vec3Array::Multiply(GetRotation(t, ref), vectors, out);
+}
+
+void Frame::TransformVectors(const Vec3Array& vectors, const std::vector<double>& ets, const Frame& ref, Vec3Array& out) const
+{
+	if(vectors.Size() != ets.size())
+		CSpiceUtil::SignalError("Frame::TransformVectors: vector and epoch counts differ");
+
+	Matrix3d rotation;
+
+	if(GetConstantRotation(ref, rotation))
+	{
+		Vec3Array::Multiply(rotation, vectors, out);
+		return;
+	}
+
+	std::vector<double> rotations;
+	GetRotations(ets, ref, rotations);
+
+	out.Resize(vectors.Size());
+	VectorRotation::Rotate(rotations.data(), vectors.x.data(), vectors.y.data(), vectors.z.data(), vectors.Size(), out.x.data(), out.y.data(), out.z.data());
+}
+
+Vector3d Frame::AxisX(const Date& t, const Frame& ref) const
+{
+	return GetRotation(t, ref).GetColumn(0);
+}
+
+Vector3d Frame::AxisY(const Date& t, const Frame& ref) const
+{
+	return GetRotation(t, ref).GetColumn(1);
+}
+
+Vector3d Frame::AxisZ(const Date& t, const Frame& ref) const
+{
+	return GetRotation(t, ref).GetColumn(2);
+}
+
+Matrix4x4 Frame::GetTransformationMatrix(const Date& t, const Frame& ref) const
+{
+	Matrix3d rotation = GetRotation(t, ref);
+
+	// Columns of the rotation are the axes of this frame expressed in ref
+	float transform[DIM][DIM] = {	(float)rotation(0, 0), (float)rotation(0, 1), (float)rotation(0, 2), 0.0f,
+									(float)rotation(1, 0), (float)rotation(1, 1), (float)rotation(1, 2), 0.0f,
+									(float)rotation(2, 0), (float)rotation(2, 1), (float)rotation(2, 2), 0.0f,
+									0.0f, 0.0f, 0.0f, 1.0f };
+
+	return Matrix4x4(transform);
 }
 
 bool Frame::HasAvailableData() const
@@ -147,16 +540,16 @@ bool Frame::HasLimitedCoverage() const
 
 Window Frame::GetCoverage() const
 {
-	std::vector<KernelData> kernels = CSpiceUtil::GetLoadedKernels("PCK");
+	const std::unordered_map<long, std::vector<PckSegment>>& segments = BinaryPck::GetSegments();
+	std::unordered_map<long, std::vector<PckSegment>>::const_iterator it = segments.find(info.classId);
 
 	Window coverage;
 
-	for(size_t i = 0; i < kernels.size(); i++)
-	{
-		std::string file = kernels[i].filename;
+	if(it == segments.end())
+		return coverage;
 
-		CSPICE_ASSERT(pckcov_c(file.c_str(), this->GetFrameInfo().classId, &coverage.GetSpiceCell()));
-	}
+	for(size_t i = 0; i < it->second.size(); i++)
+		coverage.Insert(it->second[i].start, it->second[i].stop);
 
 	return coverage;
 }
@@ -201,7 +594,7 @@ std::vector<long> Frame::GetPoolIds()
 std::vector<long> Frame::GetLoadedPckIds()
 {
 	SPICEINT_CELL(cell, CELL_SIZE_LARGE);
-	std::vector<KernelData> kernels = CSpiceUtil::GetLoadedKernels("PCK");
+	const std::vector<KernelData>& kernels = CSpiceUtil::GetLoadedKernels("PCK");
 	for(size_t i = 0; i < kernels.size(); i++)
 	{
 		CSPICE_ASSERT(pckfrm_c(kernels[i].filename.c_str(), &cell));
@@ -3,10 +3,17 @@
 #include "CSpiceCore.h"
 #include "Date.h"
 #include "Window.h"
-#include "../Math/Vector3.h"
+#include "../Math/Vector3d.h"
+#include "../Math/Matrix3d.h"
+#include "../Math/Vec3Array.h"
 #include "../Math/Matrix4x4.h"
 
 #define FRAME_NAME_MAX_LENGTH 64
+#define FRAME_MAX_CHAIN_LENGTH 32
+
+#define J2000_FRAME_ID 1
+
+struct StateArray;
 
 class Frame
 {
@@ -33,15 +40,35 @@ public:
 	~Frame();
 
 	long GetSpiceId() const;
-	std::string GetSpiceName() const;
+	const std::string& GetSpiceName() const;
 	const std::string& GetName() const;
 
-	FrameInfo GetFrameInfo() const;
+	const FrameInfo& GetFrameInfo() const;
+	long GetCenterId() const;
+
+	// Rotation from this frame to ref, evaluated once per (from, to, epoch) and cached
+	Matrix3d GetRotation(const Date& t, const Frame& ref) const;
+	bool GetConstantRotation(const Frame& ref, Matrix3d& rotation) const; // false if the rotation depends on time
+
+	// Rotations for many epochs in one pass, element (row, col) of rotation i at rotations[(3 * row + col) * ets.size() + i]
+	void GetRotations(const std::vector<double>& ets, const Frame& ref, std::vector<double>& rotations) const;
 
-	Vector3 TransformVector(const Vector3& vec, const Date& t, const Frame& ref) const;
-	Vector3 AxisX(const Date& t, const Frame& ref) const;
-	Vector3 AxisY(const Date& t, const Frame& ref) const;
-	Vector3 AxisZ(const Date& t, const Frame& ref) const;
+	// 6x6 transformations of position and velocity, matrix i of a batch is row-major at transforms[36 * i]
+	void GetStateTransformation(const Date& t, const Frame& ref, double transform[6][6]) const;
+	void GetStateTransformations(const std::vector<double>& ets, const Frame& ref, std::vector<double>& transforms) const;
+	void TransformStates(const std::vector<double>& ets, const Frame& ref, StateArray& states) const;
+
+	// Inertial frames and TK chains ending on one are a constant rotation away from J2000
+	bool IsInertial() const;
+
+	Vector3d TransformVector(const Vector3d& vec, const Date& t, const Frame& ref) const;
+	// Batch transforms, out may be vectors
+	void TransformVectors(const Vec3Array& vectors, const Date& t, const Frame& ref, Vec3Array& out) const;
+	void TransformVectors(const Vec3Array& vectors, const std::vector<double>& ets, const Frame& ref, Vec3Array& out) const;
+
+	Vector3d AxisX(const Date& t, const Frame& ref) const;
+	Vector3d AxisY(const Date& t, const Frame& ref) const;
+	Vector3d AxisZ(const Date& t, const Frame& ref) const;
 
 	Matrix4x4 GetTransformationMatrix(const Date& t, const Frame& ref) const;
 
@@ -58,11 +85,39 @@ public:
 
 private:
 	void Construct(int spiceId, const std::string& name);
+	void UpdateAnchor() const;
+	void ResolveAnchor() const;
+
+	bool GetAnchorRotation(double et, Matrix3d& rotation) const; // J2000 -> anchor, false if CSpice is needed
+	bool GetAnchorRotations(const std::vector<double>& ets, std::vector<double>& rotations) const; // left empty for J2000
+	void EvaluateAnchorLink(const Frame& ref, double et, Matrix3d& link) const;
+	void ComposeStateTransformation(const Frame& ref, const double anchorTransform[6][6], double* transform) const;
+
+	static bool FindTkParent(long id, const std::string& spiceName, std::string& parentName);
 
 private:
 	long spiceId;
 	std::string name;
 
+	// Resolved on construction
+	std::string spiceName;
+	FrameInfo info;
+
+	// First time dependent frame of the chain (or J2000), with the constant rotation from this frame to it.
+	// TK definitions come from the kernel pool, so the chain is resolved again on first use after the kernel set changes,
+	// every public path reaches it through GetConstantRotation or IsInertial
+	struct Anchor
+	{
+		long id;
+		std::string name;
+		FrameType type;
+		long classId;
+		Matrix3d rotation;
+	};
+
+	mutable Anchor anchor;
+	mutable unsigned long anchorGeneration;
+
 public:
 	static const Frame J2000;
 	static const Frame ECLIPJ2000;
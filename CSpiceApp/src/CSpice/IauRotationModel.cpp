@@ -0,0 +1,221 @@
+#include "IauRotationModel.h"
+#include "BinaryPck.h"
+
+#include <cmath>
+#include <algorithm>
+
+IauRotationModel::IauRotationModel() : bodyId(0), valid(false), phaseDegree(1)
+{
+	for(int i = 0; i < 3; i++)
+	{
+		poleRa[i] = 0.0;
+		poleDec[i] = 0.0;
+		pm[i] = 0.0;
+	}
+}
+
+bool IauRotationModel::Load(long bodyId)
+{
+	this->bodyId = bodyId;
+	this->valid = false;
+
+	std::vector<double> values;
+
+	// Constants given relative to another frame or epoch are left to CSpice
+	if(bodfnd_c(bodyId, "CONSTANTS_REF_FRAME") != SPICEFALSE || bodfnd_c(bodyId, "CONSTANTS_JED_EPOCH") != SPICEFALSE)
+		return false;
+
+	double* polynomials[3] = { poleRa, poleDec, pm };
+	const char* items[3] = { "POLE_RA", "POLE_DEC", "PM" };
+
+	for(int i = 0; i < 3; i++)
+	{
+		if(!ReadConstants(bodyId, items[i], values))
+			return false;
+
+		for(size_t k = 0; k < 3; k++)
+			polynomials[i][k] = (k < values.size()) ? values[k] : 0.0;
+	}
+
+	ReadConstants(bodyId, "NUT_PREC_RA", nutPrecRa);
+	ReadConstants(bodyId, "NUT_PREC_DEC", nutPrecDec);
+	ReadConstants(bodyId, "NUT_PREC_PM", nutPrecPm);
+
+	size_t termCount = std::max(nutPrecRa.size(), std::max(nutPrecDec.size(), nutPrecPm.size()));
+
+	if(termCount > 0)
+	{
+		// Planets and satellites share the angles of their system barycenter
+		long barycenterId = (bodyId >= 100 && bodyId < 1000) ? bodyId / 100 : bodyId;
+
+		if(bodfnd_c(barycenterId, "CONSTANTS_REF_FRAME") != SPICEFALSE || bodfnd_c(barycenterId, "CONSTANTS_JED_EPOCH") != SPICEFALSE)
+			return false;
+
+		if(!ReadConstants(barycenterId, "NUT_PREC_ANGLES", nutPrecAngles))
+			return false;
+
+		phaseDegree = 1;
+		if(ReadConstants(barycenterId, "MAX_PHASE_DEGREE", values) && !values.empty())
+			phaseDegree = (long)values[0];
+
+		if(phaseDegree < 1 || nutPrecAngles.size() < termCount * (phaseDegree + 1))
+			return false;
+
+		nutPrecRa.resize(termCount, 0.0);
+		nutPrecDec.resize(termCount, 0.0);
+		nutPrecPm.resize(termCount, 0.0);
+	}
+
+	valid = true;
+
+	return true;
+}
+
+bool IauRotationModel::IsValid() const
+{
+	return valid;
+}
+
+long IauRotationModel::GetBodyId() const
+{
+	return bodyId;
+}
+
+void IauRotationModel::GetRotation(double et, Matrix3d& rotation) const
+{
+	double ra, dec, w;
+	EvaluateAngles(et, ra, dec, w);
+
+	MakeRotation(ra, dec, w, &rotation(0, 0), 1);
+}
+
+void IauRotationModel::GetRotations(const std::vector<double>& ets, std::vector<double>& rotations) const
+{
+	size_t count = ets.size();
+	rotations.resize(9 * count);
+
+	if(count == 0)
+		return;
+
+	std::vector<double> ra(count);
+	std::vector<double> dec(count);
+	std::vector<double> w(count);
+
+	for(size_t i = 0; i < count; i++)
+		EvaluateAngles(ets[i], ra[i], dec[i], w[i]);
+
+	for(size_t i = 0; i < count; i++)
+		MakeRotation(ra[i], dec[i], w[i], &rotations[i], count);
+}
+
+const IauRotationModel* IauRotationModel::Find(long bodyId)
+{
+	EnsureValid();
+
+	std::unordered_map<long, IauRotationModel>::iterator it = models.find(bodyId);
+
+	if(it == models.end())
+	{
+		IauRotationModel& model = models[bodyId];
+
+		if(!BinaryPck::HasData(bodyId))
+			model.Load(bodyId);
+
+		return model.IsValid() ? &model : nullptr;
+	}
+
+	return it->second.IsValid() ? &it->second : nullptr;
+}
+
+void IauRotationModel::EvaluateAngles(double et, double& ra, double& dec, double& w) const
+{
+	double d = et / spd_c();
+	double t = d / 36525.0;
+
+	ra = poleRa[0] + t * (poleRa[1] + t * poleRa[2]);
+	dec = poleDec[0] + t * (poleDec[1] + t * poleDec[2]);
+	w = pm[0] + d * (pm[1] + d * pm[2]);
+
+	long stride = phaseDegree + 1;
+
+	for(size_t i = 0; i < nutPrecRa.size(); i++)
+	{
+		const double* angle = &nutPrecAngles[i * stride];
+
+		double theta = angle[phaseDegree];
+		for(long k = phaseDegree - 1; k >= 0; k--)
+			theta = theta * t + angle[k];
+
+		theta *= rpd_c();
+
+		double s = std::sin(theta);
+		double c = std::cos(theta);
+
+		ra += nutPrecRa[i] * s;
+		dec += nutPrecDec[i] * c;
+		w += nutPrecPm[i] * s;
+	}
+
+	ra *= rpd_c();
+	dec *= rpd_c();
+	w = std::fmod(w, 360.0) * rpd_c();
+}
+
+void IauRotationModel::MakeRotation(double ra, double dec, double w, double* rotation, size_t stride)
+{
+	// eul2m_c(w, halfpi - dec, halfpi + ra, 3, 1, 3) in closed form
+	double ca = -std::sin(ra);
+	double sa = std::cos(ra);
+	double cb = std::sin(dec);
+	double sb = std::cos(dec);
+	double cw = std::cos(w);
+	double sw = std::sin(w);
+
+	rotation[0 * stride] = cw * ca - sw * cb * sa;
+	rotation[1 * stride] = cw * sa + sw * cb * ca;
+	rotation[2 * stride] = sw * sb;
+	rotation[3 * stride] = -sw * ca - cw * cb * sa;
+	rotation[4 * stride] = -sw * sa + cw * cb * ca;
+	rotation[5 * stride] = cw * sb;
+	rotation[6 * stride] = sb * sa;
+	rotation[7 * stride] = -sb * ca;
+	rotation[8 * stride] = cb;
+}
+
+bool IauRotationModel::ReadConstants(long bodyId, const std::string& item, std::vector<double>& values)
+{
+	values.clear();
+
+	if(bodfnd_c(bodyId, item.c_str()) == SPICEFALSE)
+		return false;
+
+	std::string varName = "BODY" + std::to_string(bodyId) + "_" + item;
+
+	SpiceBoolean found;
+	SpiceInt size;
+	SpiceChar type;
+	CSPICE_ASSERT(dtpool_c(varName.c_str(), &found, &size, &type));
+
+	if(found == SPICEFALSE || type != 'N' || size == 0)
+		return false;
+
+	values.resize(size);
+
+	SpiceInt dim;
+	CSPICE_ASSERT(bodvcd_c(bodyId, item.c_str(), size, &dim, &values[0]));
+	values.resize(dim);
+
+	return true;
+}
+
+void IauRotationModel::EnsureValid()
+{
+	if(validGeneration == CSpiceUtil::GetKernelGeneration())
+		return;
+
+	models.clear();
+	validGeneration = CSpiceUtil::GetKernelGeneration();
+}
+
+std::unordered_map<long, IauRotationModel> IauRotationModel::models;
+unsigned long IauRotationModel::validGeneration = 0;
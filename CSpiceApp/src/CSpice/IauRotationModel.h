@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CSpiceCore.h"
+#include "CSpiceUtil.h"
+#include "../Math/Matrix3d.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// IAU rotation model of a body from text PCK constants: pole right ascension and declination,
+// prime meridian and the nutation-precession terms of its barycenter, read once from the pool
+class IauRotationModel
+{
+public:
+	IauRotationModel();
+
+	bool Load(long bodyId);
+	bool IsValid() const;
+	long GetBodyId() const;
+
+	// Rotation from J2000 to the body-fixed frame, as tipbod_c
+	void GetRotation(double et, Matrix3d& rotation) const;
+
+	// Element (row, col) of rotation i at rotations[(3 * row + col) * ets.size() + i]
+	void GetRotations(const std::vector<double>& ets, std::vector<double>& rotations) const;
+
+	// Model of a body unless it has no text constants or binary PCK data takes precedence, rebuilt when the kernel set changes
+	static const IauRotationModel* Find(long bodyId);
+
+private:
+	void EvaluateAngles(double et, double& ra, double& dec, double& w) const;
+
+	static void MakeRotation(double ra, double dec, double w, double* rotation, size_t stride);
+	static bool ReadConstants(long bodyId, const std::string& item, std::vector<double>& values);
+	static void EnsureValid();
+
+private:
+	long bodyId;
+	bool valid;
+
+	double poleRa[3];
+	double poleDec[3];
+	double pm[3];
+
+	// Nutation-precession angle i is the polynomial in centuries nutPrecAngles[i * (phaseDegree + 1) + k]
+	std::vector<double> nutPrecAngles;
+	long phaseDegree;
+
+	std::vector<double> nutPrecRa;
+	std::vector<double> nutPrecDec;
+	std::vector<double> nutPrecPm;
+
+	static std::unordered_map<long, IauRotationModel> models;
+	static unsigned long validGeneration;
+};
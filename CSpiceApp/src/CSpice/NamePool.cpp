@@ -0,0 +1,16 @@
+#include "NamePool.h"
+
+const std::string* NamePool::Intern(const std::string& name)
+{
+	std::unordered_set<std::string>& names = GetNames();
+
+	return &(*names.insert(name).first);
+}
+
+std::unordered_set<std::string>& NamePool::GetNames()
+{
+	// Function scope static, so that names can be interned during static initialisation of other units
+	static std::unordered_set<std::string> names;
+
+	return names;
+}
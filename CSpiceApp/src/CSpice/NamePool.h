@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+
+// Interned object names. Every distinct name is stored once and referenced by pointer,
+// pointers stay valid for the lifetime of the program
+class NamePool
+{
+public:
+	static const std::string* Intern(const std::string& name);
+
+private:
+	static std::unordered_set<std::string>& GetNames();
+};
@@ -0,0 +1,57 @@
+#include "ObjectArena.h"
+
+#include <new>
+
+ObjectArena::ObjectArena(size_t slabSize) : slabSize(slabSize), currentSize(0), offset(0)
+{
+
+}
+
+ObjectArena::~ObjectArena()
+{
+	Clear();
+}
+
+void* ObjectArena::Allocate(size_t size, size_t alignment)
+{
+	size_t alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+
+	if(slabs.empty() || alignedOffset + size > currentSize)
+	{
+		AddSlab(size + alignment);
+		alignedOffset = 0;
+	}
+
+	void* ptr = slabs.back() + alignedOffset;
+	offset = alignedOffset + size;
+
+	return ptr;
+}
+
+void ObjectArena::Clear()
+{
+	for(size_t i = 0; i < slabs.size(); i++)
+	{
+		::operator delete(slabs[i]);
+		slabs[i] = nullptr;
+	}
+
+	slabs.clear();
+	currentSize = 0;
+	offset = 0;
+}
+
+size_t ObjectArena::GetSlabCount() const
+{
+	return slabs.size();
+}
+
+void ObjectArena::AddSlab(size_t minSize)
+{
+	size_t size = (minSize > slabSize) ? minSize : slabSize;
+
+	// operator new returns memory aligned for any fundamental type
+	slabs.push_back((char*)::operator new(size));
+	currentSize = size;
+	offset = 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#define ARENA_SLAB_SIZE 65536
+
+// Bump allocator for objects which live until the arena is cleared. Memory is handed out from large slabs,
+// so objects allocated one after another are contiguous and teardown is one free per slab.
+// The arena doesn't run destructors, owners have to do that before Clear()
+class ObjectArena
+{
+public:
+	ObjectArena(size_t slabSize = ARENA_SLAB_SIZE);
+	~ObjectArena();
+
+	void* Allocate(size_t size, size_t alignment);
+	void Clear();
+
+	size_t GetSlabCount() const;
+
+private:
+	ObjectArena(const ObjectArena&);
+	ObjectArena& operator=(const ObjectArena&);
+
+	void AddSlab(size_t minSize);
+
+private:
+	std::vector<char*> slabs;
+	size_t slabSize;
+	size_t currentSize;
+	size_t offset;
+};
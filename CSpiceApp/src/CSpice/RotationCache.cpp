@@ -0,0 +1,62 @@
+#include "RotationCache.h"
+
+bool RotationCache::Find(long from, long to, double et, Matrix3d& rotation)
+{
+	EnsureValid();
+
+	for(int i = 0; i < ROTATION_CACHE_SIZE; i++)
+	{
+		RotationEntry& entry = entries[i];
+
+		if(entry.lastUse != 0 && entry.from == from && entry.to == to && entry.et == et)
+		{
+			entry.lastUse = ++useCounter;
+			rotation = entry.rotation;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void RotationCache::Store(long from, long to, double et, const Matrix3d& rotation)
+{
+	EnsureValid();
+
+	// Replace the least recently used entry, unused ones come first
+	int victim = 0;
+	for(int i = 1; i < ROTATION_CACHE_SIZE; i++)
+	{
+		if(entries[i].lastUse < entries[victim].lastUse)
+			victim = i;
+	}
+
+	RotationEntry& entry = entries[victim];
+	entry.from = from;
+	entry.to = to;
+	entry.et = et;
+	entry.rotation = rotation;
+	entry.lastUse = ++useCounter;
+}
+
+void RotationCache::Invalidate()
+{
+	for(int i = 0; i < ROTATION_CACHE_SIZE; i++)
+		entries[i].lastUse = 0;
+
+	useCounter = 0;
+}
+
+void RotationCache::EnsureValid()
+{
+	if(validGeneration != CSpiceUtil::GetKernelGeneration())
+	{
+		Invalidate();
+		validGeneration = CSpiceUtil::GetKernelGeneration();
+	}
+}
+
+RotationEntry RotationCache::entries[ROTATION_CACHE_SIZE];
+unsigned long RotationCache::useCounter = 0;
+unsigned long RotationCache::validGeneration = 0;
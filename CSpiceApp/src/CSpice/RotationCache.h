@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CSpiceCore.h"
+#include "CSpiceUtil.h"
+#include "../Math/Matrix3d.h"
+
+#define ROTATION_CACHE_SIZE 16
+
+struct RotationEntry
+{
+	long from;
+	long to;
+	double et;
+	Matrix3d rotation;
+	unsigned long lastUse; // 0 marks an unused entry
+};
+
+// Least recently used cache of frame rotations keyed on (from, to, epoch), dropped whenever the kernel set changes
+class RotationCache
+{
+public:
+	static bool Find(long from, long to, double et, Matrix3d& rotation);
+	static void Store(long from, long to, double et, const Matrix3d& rotation);
+
+	static void Invalidate();
+
+private:
+	static void EnsureValid();
+
+private:
+	static RotationEntry entries[ROTATION_CACHE_SIZE];
+	static unsigned long useCounter;
+	static unsigned long validGeneration;
+};
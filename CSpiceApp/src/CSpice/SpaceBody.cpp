@@ -1,5 +1,8 @@
 #include "SpaceBody.h"
 
+#include <new>
+#include <type_traits>
+
 SpaceBody::SpaceBody(long spiceId, const std::string& name) : SpaceObject(spiceId, name)
 {
 	Init();
@@ -38,6 +41,13 @@ SpaceBody* SpaceBody::Clone() const
 	return new SpaceBody(*this);
 }
 
+SpaceBody* SpaceBody::CloneInto(ObjectArena& arena) const
+{
+	void* memory = arena.Allocate(sizeof(SpaceBody), std::alignment_of<SpaceBody>::value);
+
+	return new(memory) SpaceBody(*this);
+}
+
 bool SpaceBody::HasIAUFrame() const
 {
 	std::string frameName = "IAU_" + GetSpiceName();
@@ -29,6 +29,7 @@ public:
 	~SpaceBody();
 
 	virtual SpaceBody* Clone() const;
+	virtual SpaceBody* CloneInto(ObjectArena& arena) const;
 
 	bool HasIAUFrame() const;
 	Frame GetIAUFrame() const;
@@ -1,4 +1,10 @@
 #include "SpaceObject.h"
+#include "Ephemeris.h"
+#include "BodyCatalog.h"
+#include "CoverageIndex.h"
+
+#include <new>
+#include <type_traits>
 
 SpaceObject::SpaceObject(long spiceId, const std::string& name)
 {
@@ -7,11 +13,9 @@ SpaceObject::SpaceObject(long spiceId, const std::string& name)
 
 SpaceObject::SpaceObject(const std::string& spiceName, const std::string& name)
 {
-	SpiceInt spiceId;
-	SpiceBoolean found;
-	CSPICE_ASSERT( bodn2c_c(spiceName.c_str(), &spiceId, &found) );
+	long spiceId;
 
-	if(!found)
+	if(!TranslateName(spiceName, spiceId))
 		CSpiceUtil::SignalError("Cannot translate " + spiceName + " into ID code");
 
 	Construct(spiceId, name);
@@ -26,11 +30,11 @@ void SpaceObject::Construct(long spiceId, const std::string& name)
 
 	if(name != "")
 	{
-		this->name = name;
+		this->name = NamePool::Intern(name);
 	}
 	else
 	{
-		this->name = GetSpiceName();
+		this->name = NamePool::Intern(GetSpiceName());
 	}
 }
 
@@ -44,6 +48,13 @@ SpaceObject* SpaceObject::Clone() const
 	return new SpaceObject(*this);
 }
 
+SpaceObject* SpaceObject::CloneInto(ObjectArena& arena) const
+{
+	void* memory = arena.Allocate(sizeof(SpaceObject), std::alignment_of<SpaceObject>::value);
+
+	return new(memory) SpaceObject(*this);
+}
+
 long SpaceObject::GetSpiceId() const
 {
 	return spiceId;
@@ -51,53 +62,72 @@ long SpaceObject::GetSpiceId() const
 
 std::string SpaceObject::GetSpiceName() const
 {
-	char objName[OBJECT_NAME_MAX_LENGTH];
-	SpiceBoolean found;
-	CSPICE_ASSERT(bodc2n_c(spiceId, OBJECT_NAME_MAX_LENGTH, objName, &found));
-
-	return std::string(objName);
+	return BodyCatalog::GetName(spiceId);
 }
 
 const std::string& SpaceObject::GetName() const
 {
-	return name;
+	return *name;
 }
 
 Vector3T<Length> SpaceObject::GetPosition(const Date& t, const SpaceObject& relativeTo, const Frame& frame) const
 {
-	double etTime = t.AsDouble();
-	long observerId = relativeTo.GetSpiceId();
-	std::string frameName = frame.GetSpiceName();
+	return MakePosition(t, relativeTo.GetSpiceId(), frame);
+}
 
-	double position[3];
-	double lt;
+Vector3T<Length> SpaceObject::GetPosition(const Date& t, const Frame& frame) const
+{
+	return MakePosition(t, frame.GetCenterId(), frame);
+}
 
-	CSPICE_ASSERT(spkgps_c(this->spiceId, etTime, frameName.c_str(), observerId, position, &lt));
+Vector3T<Velocity> SpaceObject::GetVelocity(const Date& t, const SpaceObject& relativeTo, const Frame& frame) const
+{
+	return MakeVelocity(t, relativeTo.GetSpiceId(), frame);
+}
 
-	Length pos[3];
-	for(int i = 0; i < 3; i++)
-		pos[i] = Length(position[i], Units::Metric::kilometers);
+Vector3T<Velocity> SpaceObject::GetVelocity(const Date& t, const Frame& frame) const
+{
+	return MakeVelocity(t, frame.GetCenterId(), frame);
+}
 
-	return Vector3T<Length>(pos);
+StateVector SpaceObject::GetState(const Date& t, const SpaceObject& relativeTo, const Frame& frame) const
+{
+	return MakeState(t, relativeTo.GetSpiceId(), frame);
 }
 
-Vector3T<Length> SpaceObject::GetPosition(const Date& t, const Frame& frame) const
+StateVector SpaceObject::GetState(const Date& t, const Frame& frame) const
 {
-	Frame::FrameInfo frInfo = frame.GetFrameInfo();
-	
-	return GetPosition(t, SpaceObject(frInfo.centerId), frame);
+	return MakeState(t, frame.GetCenterId(), frame);
 }
 
-Vector3T<Velocity> SpaceObject::GetVelocity(const Date& t, const SpaceObject& relativeTo, const Frame& frame) const
+void SpaceObject::GetStates(const std::vector<double>& ets, const SpaceObject& relativeTo, const Frame& frame, StateArray& states) const
 {
-	double etTime = t.AsDouble();
-	long observerId = relativeTo.GetSpiceId();
-	std::string frameName = frame.GetSpiceName();
+	FillStates(ets, relativeTo.GetSpiceId(), frame, states);
+}
+
+void SpaceObject::GetStates(const std::vector<double>& ets, const Frame& frame, StateArray& states) const
+{
+	FillStates(ets, frame.GetCenterId(), frame, states);
+}
 
+Vector3T<Length> SpaceObject::MakePosition(const Date& t, long observerId, const Frame& frame) const
+{
 	double state[6];
-	double lt;
 
-	CSPICE_ASSERT(spkgeo_c(this->spiceId, etTime, frameName.c_str(), observerId, state, &lt));
+	EvaluateState(t.AsDouble(), observerId, frame, state);
+
+	Length pos[3];
+	for(int i = 0; i < 3; i++)
+		pos[i] = Length(state[i], Units::Metric::kilometers);
+
+	return Vector3T<Length>(pos);
+}
+
+Vector3T<Velocity> SpaceObject::MakeVelocity(const Date& t, long observerId, const Frame& frame) const
+{
+	double state[6];
+
+	EvaluateState(t.AsDouble(), observerId, frame, state);
 
 	Velocity vel[3];
 	for(int i = 0; i < 3; i++)
@@ -108,27 +138,84 @@ Vector3T<Velocity> SpaceObject::GetVelocity(const Date& t, const SpaceObject& re
 	return Vector3T<Velocity>(vel);
 }
 
-Vector3T<Velocity> SpaceObject::GetVelocity(const Date& t, const Frame& frame) const
+StateVector SpaceObject::MakeState(const Date& t, long observerId, const Frame& frame) const
 {
-	Frame::FrameInfo frInfo = frame.GetFrameInfo();
+	double state[6];
+
+	EvaluateState(t.AsDouble(), observerId, frame, state);
 
-	return GetVelocity(t, SpaceObject(frInfo.centerId), frame);
+	StateVector res;
+	res.position.Set(Length(state[0], Units::Metric::kilometers), Length(state[1], Units::Metric::kilometers), Length(state[2], Units::Metric::kilometers));
+	res.velocity.Set(Velocity(state[3], Units::Metric::kmps), Velocity(state[4], Units::Metric::kmps), Velocity(state[5], Units::Metric::kmps));
+
+	return res;
 }
 
-Window SpaceObject::GetCoverage() const
+void SpaceObject::FillStates(const std::vector<double>& ets, long observerId, const Frame& frame, StateArray& states) const
 {
-	std::vector<KernelData> kernels = CSpiceUtil::GetLoadedKernels("SPK");
+	// States in inertial frames are evaluated in J2000 and rotated all at once afterwards
+	Matrix3d rotation;
+	bool rotate = frame.GetSpiceId() != J2000_FRAME_ID && Frame::J2000.GetConstantRotation(frame, rotation);
+
+	const std::string& frameName = rotate ? Frame::J2000.GetSpiceName() : frame.GetSpiceName();
 
-	Window coverage;
+	size_t count = ets.size();
+	states.Resize(count);
 
-	for(size_t i = 0; i < kernels.size(); i++)
+	double* components[6] = { states.position.x.Data(), states.position.y.Data(), states.position.z.Data(),
+							  states.velocity.x.Data(), states.velocity.y.Data(), states.velocity.z.Data() };
+
+	double state[6];
+
+	for(size_t i = 0; i < count; i++)
 	{
-		std::string file = kernels[i].filename;
+		Ephemeris::GetState(this->spiceId, ets[i], frameName, observerId, state);
+
+		for(int k = 0; k < 6; k++)
+			components[k][i] = state[k];
+	}
+
+	// CSpice works in km and km/s, one scaling pass per component brings them to base units
+	for(int k = 0; k < 3; k++)
+		QuantityArray<Length>::Scale(components[k], count, Units::Metric::kilometers.GetMultiplier(), components[k]);
+	for(int k = 3; k < 6; k++)
+		QuantityArray<Velocity>::Scale(components[k], count, Units::Metric::kmps.GetMultiplier(), components[k]);
+
+	if(rotate)
+		states.Rotate(rotation);
+}
 
-		CSPICE_ASSERT( spkcov_c(file.c_str(), this->spiceId, &coverage.GetSpiceCell()) );
+void SpaceObject::EvaluateState(double et, long observerId, const Frame& frame, double state[6]) const
+{
+	Matrix3d rotation;
+
+	if(frame.GetSpiceId() == J2000_FRAME_ID || !Frame::J2000.GetConstantRotation(frame, rotation))
+	{
+		Ephemeris::GetState(this->spiceId, et, frame.GetSpiceName(), observerId, state);
+		return;
 	}
 
-	return coverage;
+	// Constant rotation from J2000, velocities need no rotation derivative
+	double j2000State[6];
+	Ephemeris::GetState(this->spiceId, et, Frame::J2000.GetSpiceName(), observerId, j2000State);
+
+	(rotation * Vector3d(j2000State)).CopyTo(state);
+	(rotation * Vector3d(j2000State + 3)).CopyTo(state + 3);
+}
+
+Window SpaceObject::GetCoverage() const
+{
+	return CoverageIndex::GetCoverage(this->spiceId).window;
+}
+
+bool SpaceObject::IsCovered(const Date& t) const
+{
+	return CoverageIndex::IsCovered(this->spiceId, t.AsDouble());
+}
+
+void SpaceObject::IsCovered(const std::vector<double>& ets, std::vector<bool>& mask) const
+{
+	CoverageIndex::GetCoverage(this->spiceId).window.IsIncluded(ets, mask);
 }
 
 bool SpaceObject::IsBarycenter() const
@@ -168,95 +255,71 @@ bool SpaceObject::IsSun() const
 
 bool SpaceObject::ValidateId(long id)
 {
-	char objName[OBJECT_NAME_MAX_LENGTH];
+	return BodyCatalog::IsValid(id);
+}
+
+bool SpaceObject::TranslateName(const std::string& spiceName, long& spiceId)
+{
+	SpiceInt id;
 	SpiceBoolean found;
-	CSPICE_ASSERT(bodc2n_c(id, OBJECT_NAME_MAX_LENGTH, objName, &found));
+	CSPICE_ASSERT( bodn2c_c(spiceName.c_str(), &id, &found) );
+
+	if(found != SPICEFALSE)
+		spiceId = id;
 
 	return found != SPICEFALSE;
 }
 
 bool SpaceObject::IsBarycenter(long id)
 {
-	if(ValidateId(id) == false)
-		return false;
-
-	return IsPlanetaryBarycenter(id) || IsSSB(id);
+	return BodyCatalog::HasFlags(id, BF_BARYCENTER);
 }
 
 bool SpaceObject::IsPlanetaryBarycenter(long id)
 {
-	if(ValidateId(id) == false)
-		return false;
-
-	return (id > 0 && id < 10);
+	return BodyCatalog::HasFlags(id, BF_PLANETARY_BARYCENTER);
 }
 
 bool SpaceObject::IsSSB(long id)
 {
-	if(ValidateId(id) == false)
-		return false;
-
-	return id == SSB_SPICE_ID;
+	return BodyCatalog::HasFlags(id, BF_SSB);
 }
 
 bool SpaceObject::IsPlanet(long id)
 {
-	if(ValidateId(id) == false)
-		return false;
-
-	return (id > 100 && id < 1000 && (id % 100) == 99);
+	return BodyCatalog::HasFlags(id, BF_PLANET);
 }
 
 bool SpaceObject::IsMoon(long id)
 {
-	if(ValidateId(id) == false)
-		return false;
-
-	return IsBody(id) && !IsPlanet(id) && !IsSun(id);
+	return BodyCatalog::HasFlags(id, BF_MOON);
 }
 
 bool SpaceObject::IsBody(long id)
 {
-	if(ValidateId(id) == false)
-		return false;
-
-	return ((id > 100 && id < 1000) || IsSun(id));
+	return BodyCatalog::HasFlags(id, BF_BODY);
 }
 
 bool SpaceObject::IsSun(long id)
 {
-	if(ValidateId(id) == false)
-		return false;
-
-	return id == SUN_SPICE_ID;
+	return BodyCatalog::HasFlags(id, BF_SUN);
 }
 
 std::vector<long> SpaceObject::FindChildObjectIds(long id, bool includeMain)
 {
+	const std::vector<long>& children = BodyCatalog::GetChildren(id);
+
+	if(includeMain || !IsPlanetaryBarycenter(id))
+		return children;
+
+	// X99 - id of a most massive body in the X-th barycenter
 	std::vector<long> ids;
+	ids.reserve(children.size());
 
-	if(id == SSB_SPICE_ID)
-	{
-		for(int i = 1; i <= 10; i++)
-		{
-			if(ValidateId(i))
-				ids.push_back(i);
-		}
-	}
-	else if(IsPlanetaryBarycenter(id))
+	for(size_t i = 0; i < children.size(); i++)
 	{
-		int upperSatelliteId;
-		if(includeMain)
-			upperSatelliteId = 99; // X99 - id of a most massive body in the X-th barycenter
-		else
-			upperSatelliteId = 98;
-
-		for(int i = 1; i <= upperSatelliteId; i++)
-		{
-			long satelliteId = 100 * id + i;
-			if(ValidateId(satelliteId))
-				ids.push_back(satelliteId);
-		}
+		if(children[i] % 100 != 99)
+			ids.push_back(children[i]);
 	}
 
 	return ids;
@@ -284,30 +347,12 @@ std::vector<long> SpaceObject::FindMoonIds(long id)
 
 long SpaceObject::FindParentObjectId(long id)
 {
-	if(id == SUN_SPICE_ID || IsPlanetaryBarycenter(id))
-	{
-		return SSB.GetSpiceId();
-	}
-	else if(IsBody(id))
-	{
-		return id / 100;
-	}
-	else
-	{
-		return id;
-	}
+	return BodyCatalog::GetParentId(id);
 }
 
 std::vector<long> SpaceObject::GetLoadedSpkIds()
 {
-	SPICEINT_CELL(cell, CELL_SIZE_LARGE);
-	std::vector<KernelData> kernels = CSpiceUtil::GetLoadedKernels("SPK");
-	for(size_t i = 0; i < kernels.size(); i++)
-	{
-		CSPICE_ASSERT(spkobj_c(kernels[i].filename.c_str(), &cell));
-	}
-
-	return CSpiceUtil::IntCellToVector(cell);
+	return CoverageIndex::GetBodyIds();
 }
 
 const SpaceObject SpaceObject::SSB = SpaceObject(SSB_SPICE_ID, "Solar System Barycenter");
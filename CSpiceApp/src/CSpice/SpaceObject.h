@@ -7,7 +7,10 @@
 #include "Frame.h"
 #include "Date.h"
 #include "Window.h"
-#include "../Math/Vector3.h"
+#include "NamePool.h"
+#include "ObjectArena.h"
+#include "StateArray.h"
+#include "../Math/Vec3Array.h"
 #include "../Math/Vector3T.h"
 
 #define SSB_SPICE_ID 0
@@ -15,6 +18,12 @@
 
 #define OBJECT_NAME_MAX_LENGTH 128
 
+struct StateVector
+{
+	Vector3T<Length> position;
+	Vector3T<Velocity> velocity;
+};
+
 class SpaceObject
 {
 public:
@@ -23,6 +32,7 @@ public:
 	virtual ~SpaceObject();
 
 	virtual SpaceObject* Clone() const;
+	virtual SpaceObject* CloneInto(ObjectArena& arena) const;
 
 
 	long GetSpiceId() const;
@@ -33,8 +43,15 @@ public:
 	Vector3T<Length> GetPosition(const Date& t, const Frame& frame) const;
 	Vector3T<Velocity> GetVelocity(const Date& t, const SpaceObject& relativeTo, const Frame& frame) const;
 	Vector3T<Velocity> GetVelocity(const Date& t, const Frame& frame) const;
+	StateVector GetState(const Date& t, const SpaceObject& relativeTo, const Frame& frame) const;
+	StateVector GetState(const Date& t, const Frame& frame) const;
+
+	void GetStates(const std::vector<double>& ets, const SpaceObject& relativeTo, const Frame& frame, StateArray& states) const;
+	void GetStates(const std::vector<double>& ets, const Frame& frame, StateArray& states) const;
 
 	Window GetCoverage() const;
+	bool IsCovered(const Date& t) const;
+	void IsCovered(const std::vector<double>& ets, std::vector<bool>& mask) const; // ets sorted ascending
 
 	bool IsBarycenter() const;
 	bool IsPlanetaryBarycenter() const;
@@ -46,6 +63,7 @@ public:
 
 
 	static bool ValidateId(long id);
+	static bool TranslateName(const std::string& spiceName, long& spiceId);
 
 	static bool IsBarycenter(long id);
 	static bool IsPlanetaryBarycenter(long id);
@@ -65,9 +83,15 @@ public:
 private:
 	void Construct(long spiceId, const std::string& name);
 
+	Vector3T<Length> MakePosition(const Date& t, long observerId, const Frame& frame) const;
+	Vector3T<Velocity> MakeVelocity(const Date& t, long observerId, const Frame& frame) const;
+	StateVector MakeState(const Date& t, long observerId, const Frame& frame) const;
+	void FillStates(const std::vector<double>& ets, long observerId, const Frame& frame, StateArray& states) const;
+	void EvaluateState(double et, long observerId, const Frame& frame, double state[6]) const;
+
 protected:
 	long spiceId;
-	std::string name;
+	const std::string* name; // interned in NamePool
 
 public:
 	static const SpaceObject SSB; // Solar System Barycenter
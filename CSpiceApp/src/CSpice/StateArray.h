@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../Math/Matrix3d.h"
+#include "../Math/QuantityArray.h"
+#include "../Math/VectorRotation.h"
+
+// Structure-of-arrays state output of batch queries
+struct StateArray
+{
+public:
+	void Resize(size_t count)
+	{
+		position.Resize(count);
+		velocity.Resize(count);
+	}
+
+	size_t Size() const
+	{
+		return position.Size();
+	}
+
+	// Same rotation applied to every position and velocity, in place
+	void Rotate(const Matrix3d& rotation)
+	{
+		VectorRotation::Rotate(rotation.GetData(), position.x.Data(), position.y.Data(), position.z.Data(), position.Size(), position.x.Data(), position.y.Data(), position.z.Data());
+		VectorRotation::Rotate(rotation.GetData(), velocity.x.Data(), velocity.y.Data(), velocity.z.Data(), velocity.Size(), velocity.x.Data(), velocity.y.Data(), velocity.z.Data());
+	}
+
+public:
+	Vector3TArray<Length> position;
+	Vector3TArray<Velocity> velocity;
+};
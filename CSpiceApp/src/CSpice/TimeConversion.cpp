@@ -0,0 +1,390 @@
+#include "TimeConversion.h"
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+double TimeConversion::UtcToEt(const std::string& str)
+{
+	double et;
+
+	if(TryUtcToEt(str.c_str(), et))
+		return et;
+
+	CSPICE_ASSERT(str2et_c(str.c_str(), &et));
+
+	return et;
+}
+
+double TimeConversion::UtcToEt(const UtcCalendar& utc)
+{
+	const LeapSecondTable* lsk = GetLeapSecondTable();
+
+	double et;
+	if(lsk != nullptr && FormalToEt(*lsk, utc, et))
+		return et;
+
+	char str[64];
+	std::snprintf(str, sizeof(str), "%04d-%02d-%02dT%02d:%02d:%012.9f", utc.year, utc.month, utc.day, utc.hour, utc.minute, utc.second);
+
+	CSPICE_ASSERT(str2et_c(str, &et));
+
+	return et;
+}
+
+double TimeConversion::UtcToEt(int year, int month, int day, int hour, int minute, double second)
+{
+	UtcCalendar utc = { year, month, day, hour, minute, second };
+
+	return UtcToEt(utc);
+}
+
+void TimeConversion::UtcToEt(const std::vector<std::string>& strs, std::vector<double>& ets)
+{
+	ets.resize(strs.size());
+
+	const LeapSecondTable* lsk = GetLeapSecondTable();
+
+	for(size_t i = 0; i < strs.size(); i++)
+	{
+		UtcCalendar utc;
+
+		if(lsk != nullptr && ParseIso(strs[i].c_str(), utc) && FormalToEt(*lsk, utc, ets[i]))
+			continue;
+
+		CSPICE_ASSERT(str2et_c(strs[i].c_str(), &ets[i]));
+	}
+}
+
+bool TimeConversion::TryUtcToEt(const char* str, double& et)
+{
+	const LeapSecondTable* lsk = GetLeapSecondTable();
+	if(lsk == nullptr)
+		return false;
+
+	UtcCalendar utc;
+
+	return ParseIso(str, utc) && FormalToEt(*lsk, utc, et);
+}
+
+static bool ParseDigits(const char*& p, int count, int& value)
+{
+	value = 0;
+
+	for(int i = 0; i < count; i++, p++)
+	{
+		if(*p < '0' || *p > '9')
+			return false;
+
+		value = 10 * value + (*p - '0');
+	}
+
+	return true;
+}
+
+bool TimeConversion::ParseIso(const char* str, UtcCalendar& utc)
+{
+	const char* p = str;
+
+	while(*p == ' ')
+		p++;
+
+	// YYYY-MM-DD or YYYY-DDD
+	if(!ParseDigits(p, 4, utc.year) || *p++ != '-')
+		return false;
+
+	const char* dateStart = p;
+	while(*p >= '0' && *p <= '9')
+		p++;
+
+	size_t dateDigits = p - dateStart;
+	p = dateStart;
+
+	if(dateDigits == 2)
+	{
+		if(!ParseDigits(p, 2, utc.month) || *p++ != '-' || !ParseDigits(p, 2, utc.day))
+			return false;
+
+		if(utc.month < 1 || utc.month > 12 || utc.day < 1 || utc.day > DaysInMonth(utc.year, utc.month))
+			return false;
+	}
+	else if(dateDigits == 3)
+	{
+		int doy;
+		if(!ParseDigits(p, 3, doy))
+			return false;
+
+		int daysInYear = DaysInMonth(utc.year, 2) == 29 ? 366 : 365;
+		if(doy < 1 || doy > daysInYear)
+			return false;
+
+		utc.month = 1;
+		while(doy > DaysInMonth(utc.year, utc.month))
+			doy -= DaysInMonth(utc.year, utc.month++);
+
+		utc.day = doy;
+	}
+	else
+	{
+		return false;
+	}
+
+	utc.hour = 0;
+	utc.minute = 0;
+	utc.second = 0.0;
+
+	// Optional THH:MM[:SS[.fff]]
+	if(*p == 'T' || (*p == ' ' && p[1] >= '0' && p[1] <= '9'))
+	{
+		p++;
+
+		if(!ParseDigits(p, 2, utc.hour) || *p++ != ':' || !ParseDigits(p, 2, utc.minute))
+			return false;
+
+		if(*p == ':')
+		{
+			p++;
+
+			int seconds;
+			if(!ParseDigits(p, 2, seconds))
+				return false;
+
+			utc.second = seconds;
+
+			if(*p == '.')
+			{
+				p++;
+
+				// Accumulate the fraction as an integer so it is rounded only once
+				double fraction = 0.0;
+				double scale = 1.0;
+
+				while(*p >= '0' && *p <= '9')
+				{
+					if(scale < 1e15)
+					{
+						fraction = 10.0 * fraction + (*p - '0');
+						scale *= 10.0;
+					}
+					p++;
+				}
+
+				utc.second += fraction / scale;
+			}
+		}
+
+		// Whether a 61st second exists is checked against the leap second table on conversion
+		if(utc.hour > 23 || utc.minute > 59 || utc.second >= 61.0)
+			return false;
+	}
+
+	while(*p == ' ')
+		p++;
+
+	return *p == '\0';
+}
+
+const LeapSecondTable* TimeConversion::GetLeapSecondTable()
+{
+	if(loadedGeneration != CSpiceUtil::GetKernelGeneration())
+	{
+		tableValid = LoadTable();
+		loadedGeneration = CSpiceUtil::GetKernelGeneration();
+	}
+
+	return tableValid ? &table : nullptr;
+}
+
+bool TimeConversion::FormalToEt(const LeapSecondTable& table, const UtcCalendar& utc, double& et)
+{
+	// Out of range fields are left to str2et_c, which reports them
+	if(utc.month < 1 || utc.month > 12 || utc.day < 1 || utc.day > DaysInMonth(utc.year, utc.month))
+		return false;
+	if(utc.hour < 0 || utc.hour > 23 || utc.minute < 0 || utc.minute > 59 || !(utc.second >= 0.0 && utc.second < 61.0))
+		return false;
+
+	// Formal seconds count every day as 86400 seconds, J2000 is noon of 2000-01-01
+	double dayStart = (DaysFromCivil(utc.year, utc.month, utc.day) - UNIX_DAYS_AT_J2000) * SECONDS_PER_DAY - 0.5 * SECONDS_PER_DAY;
+
+	// The offset in effect at the start of the day, so the day containing a leap second keeps its own
+	std::vector<double>::const_iterator it = std::upper_bound(table.epochs.begin(), table.epochs.end(), dayStart);
+	if(it == table.epochs.begin())
+		return false;
+
+	size_t next = it - table.epochs.begin();
+	double deltaAt = table.offsets[next - 1];
+
+	// Only the last minute of a day ending in a leap second has a 61st second
+	if(utc.second >= 60.0)
+	{
+		bool leapDay = next < table.epochs.size() && table.epochs[next] == dayStart + SECONDS_PER_DAY && table.offsets[next] > deltaAt;
+
+		if(!leapDay || utc.hour != 23 || utc.minute != 59)
+			return false;
+	}
+
+	double formal = dayStart + 3600.0 * utc.hour + 60.0 * utc.minute + utc.second;
+	double tdt = formal + deltaAt + table.deltaTA;
+
+	// TDB - TDT = K sin(E), E = M + EB sin(M), M = M0 + M1 * TDT
+	double m = table.m[0] + table.m[1] * tdt;
+	double e = m + table.eb * std::sin(m);
+
+	et = tdt + table.k * std::sin(e);
+
+	return true;
+}
+
+bool TimeConversion::EtToUtc(double et, double& dayStart, double& timeOfDay, double& dayLength)
+{
+	const LeapSecondTable* lsk = GetLeapSecondTable();
+	if(lsk == nullptr)
+		return false;
+
+	const std::vector<double>& epochs = lsk->epochs;
+	const std::vector<double>& offsets = lsk->offsets;
+
+	// TDB - TDT is below 2 ms and changes slowly, so fixed point iteration converges in a couple of steps
+	double tdt = et;
+	for(int i = 0; i < 3; i++)
+	{
+		double m = lsk->m[0] + lsk->m[1] * tdt;
+		double e = m + lsk->eb * std::sin(m);
+
+		tdt = et - lsk->k * std::sin(e);
+	}
+
+	double tai = tdt - lsk->deltaTA;
+
+	// Last offset already in effect in TAI
+	size_t idx = epochs.size();
+	while(idx > 0 && epochs[idx - 1] + offsets[idx - 1] > tai)
+		idx--;
+
+	if(idx == 0)
+		return false;
+	idx--;
+
+	double formal = tai - offsets[idx];
+
+	// Inside an inserted leap second the formal time has already reached the next epoch
+	if(idx + 1 < epochs.size() && formal >= epochs[idx + 1])
+	{
+		dayStart = epochs[idx + 1] - SECONDS_PER_DAY;
+		timeOfDay = formal - dayStart;
+		dayLength = SECONDS_PER_DAY + (offsets[idx + 1] - offsets[idx]);
+
+		return true;
+	}
+
+	dayStart = std::floor((formal + 0.5 * SECONDS_PER_DAY) / SECONDS_PER_DAY) * SECONDS_PER_DAY - 0.5 * SECONDS_PER_DAY;
+	timeOfDay = formal - dayStart;
+	dayLength = SECONDS_PER_DAY;
+
+	if(idx + 1 < epochs.size() && epochs[idx + 1] == dayStart + SECONDS_PER_DAY)
+		dayLength += offsets[idx + 1] - offsets[idx];
+
+	return true;
+}
+
+long TimeConversion::DaysFromCivil(long year, int month, int day)
+{
+	year -= month <= 2;
+
+	long era = (year >= 0 ? year : year - 399) / 400;
+	long yoe = year - era * 400;
+	long doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+	return era * 146097 + doe - 719468;
+}
+
+void TimeConversion::CivilFromDays(long days, int& year, int& month, int& day)
+{
+	days += 719468;
+
+	long era = (days >= 0 ? days : days - 146096) / 146097;
+	long doe = days - era * 146097;
+	long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	long mp = (5 * doy + 2) / 153;
+
+	day = (int)(doy - (153 * mp + 2) / 5 + 1);
+	month = (int)(mp < 10 ? mp + 3 : mp - 9);
+	year = (int)(yoe + era * 400 + (month <= 2));
+}
+
+int TimeConversion::DaysInMonth(int year, int month)
+{
+	static const int days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+	if(month == 2 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0))
+		return 29;
+
+	return days[month - 1];
+}
+
+bool TimeConversion::LoadTable()
+{
+	table.epochs.clear();
+	table.offsets.clear();
+
+	std::vector<double> values;
+
+	if(!ReadConstants(LSK_DELTA_T_A, values) || values.size() != 1)
+		return false;
+	table.deltaTA = values[0];
+
+	if(!ReadConstants(LSK_K, values) || values.size() != 1)
+		return false;
+	table.k = values[0];
+
+	if(!ReadConstants(LSK_EB, values) || values.size() != 1)
+		return false;
+	table.eb = values[0];
+
+	if(!ReadConstants(LSK_M, values) || values.size() != 2)
+		return false;
+	table.m[0] = values[0];
+	table.m[1] = values[1];
+
+	// Pairs of offset and the epoch it starts at
+	if(!ReadConstants(LSK_DELTA_AT, values) || values.empty() || values.size() % 2 != 0)
+		return false;
+
+	for(size_t i = 0; i < values.size(); i += 2)
+	{
+		if(!table.epochs.empty() && values[i + 1] <= table.epochs.back())
+			return false;
+
+		table.offsets.push_back(values[i]);
+		table.epochs.push_back(values[i + 1]);
+	}
+
+	return true;
+}
+
+bool TimeConversion::ReadConstants(const char* name, std::vector<double>& values)
+{
+	values.clear();
+
+	SpiceBoolean found;
+	SpiceInt size;
+	SpiceChar type;
+	CSPICE_ASSERT(dtpool_c(name, &found, &size, &type));
+
+	if(found == SPICEFALSE || type != 'N' || size == 0)
+		return false;
+
+	values.resize(size);
+
+	SpiceInt count;
+	CSPICE_ASSERT(gdpool_c(name, 0, size, &count, &values[0], &found));
+	values.resize(count);
+
+	return found != SPICEFALSE;
+}
+
+LeapSecondTable TimeConversion::table;
+bool TimeConversion::tableValid = false;
+unsigned long TimeConversion::loadedGeneration = 0;
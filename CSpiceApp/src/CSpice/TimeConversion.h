@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CSpiceCore.h"
+#include "CSpiceUtil.h"
+
+#include <string>
+#include <vector>
+
+#define LSK_DELTA_T_A "DELTET/DELTA_T_A"
+#define LSK_K "DELTET/K"
+#define LSK_EB "DELTET/EB"
+#define LSK_M "DELTET/M"
+#define LSK_DELTA_AT "DELTET/DELTA_AT"
+
+#define SECONDS_PER_DAY 86400.0
+#define UNIX_DAYS_AT_J2000 10957 // days from 1970-01-01 to 2000-01-01
+
+struct UtcCalendar
+{
+	int year;
+	int month;
+	int day;
+	int hour;
+	int minute;
+	double second;
+};
+
+// Leap second table and TDB-TDT model of the loaded LSK, read once per kernel set
+struct LeapSecondTable
+{
+	double deltaTA;
+	double k;
+	double eb;
+	double m[2];
+
+	// Formal UTC seconds past J2000 at which each TAI-UTC offset takes effect, ascending
+	std::vector<double> epochs;
+	std::vector<double> offsets;
+};
+
+// Native UTC and ET conversion from the leap seconds of the loaded LSK.
+// Covers ISO calendar and day of year strings from the first leap second epoch on, everything else goes through str2et_c.
+class TimeConversion
+{
+public:
+	static double UtcToEt(const std::string& str);
+	static double UtcToEt(const UtcCalendar& utc);
+	static double UtcToEt(int year, int month, int day, int hour, int minute, double second);
+
+	static void UtcToEt(const std::vector<std::string>& strs, std::vector<double>& ets);
+
+	// False if the string is not in one of the natively handled forms or outside the table
+	static bool TryUtcToEt(const char* str, double& et);
+
+	static bool ParseIso(const char* str, UtcCalendar& utc);
+
+	// UTC day of et as its start in formal seconds past J2000 and the seconds into it, dayLength is 86401 on leap second days
+	static bool EtToUtc(double et, double& dayStart, double& timeOfDay, double& dayLength);
+
+	// Days since 1970-01-01 in the proleptic Gregorian calendar
+	static long DaysFromCivil(long year, int month, int day);
+	static void CivilFromDays(long days, int& year, int& month, int& day);
+
+	static const LeapSecondTable* GetLeapSecondTable();
+
+private:
+	static bool FormalToEt(const LeapSecondTable& table, const UtcCalendar& utc, double& et);
+	static int DaysInMonth(int year, int month);
+
+	static bool LoadTable();
+	static bool ReadConstants(const char* name, std::vector<double>& values);
+
+private:
+	static LeapSecondTable table;
+	static bool tableValid;
+	static unsigned long loadedGeneration;
+};
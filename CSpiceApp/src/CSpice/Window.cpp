@@ -1,54 +1,145 @@
 #include "Window.h"
 
-Window::Window()
+#include <algorithm>
+
+WindowCell::WindowCell(size_t capacity)
 {
-	SPICEDOUBLE_CELL(newCell, 2 * WINDOW_MAX_INTERVALS);
+	Bind(capacity, 0);
+}
 
-	this->cell = newCell;
+WindowCell::WindowCell(const WindowCell& other) : storage(other.storage)
+{
+	Bind(other.cell.size, other.cell.card);
 }
 
-Window::Window(SpiceCell cell)
+WindowCell& WindowCell::operator=(const WindowCell& other)
 {
-	SPICEDOUBLE_CELL(newCell, 2 * WINDOW_MAX_INTERVALS);
+	if(this == &other)
+		return *this;
 
-	copy_c(&cell, &newCell);
+	storage = other.storage;
+	Bind(other.cell.size, other.cell.card);
 
-	this->cell = newCell;
+	return *this;
 }
 
-std::vector<Interval> Window::GetIntervals() const
+SpiceCell& WindowCell::GetSpiceCell()
 {
-	SpiceCell cellCopy = cell;
+	return cell;
+}
 
-	std::vector<Interval> intervals;
+void WindowCell::Bind(size_t capacity, long card)
+{
+	storage.resize(SPICE_CELL_CTRLSZ + capacity);
+
+	// Not initialised, so CSpice syncs its control area from size and card on first use
+	cell.dtype = SPICE_DP;
+	cell.length = 0;
+	cell.size = (SpiceInt)capacity;
+	cell.card = card;
+	cell.isSet = SPICETRUE;
+	cell.adjust = SPICEFALSE;
+	cell.init = SPICEFALSE;
+	cell.base = &storage[0];
+	cell.data = &storage[SPICE_CELL_CTRLSZ];
+}
+
+Window::Window()
+{
+
+}
+
+Window::Window(const SpiceCell& cell)
+{
+	if(cell.dtype != SPICE_DP)
+		CSpiceUtil::SignalError("Window expected double cell");
+
+	SpiceCell cellCopy = cell;
 
 	long count = wncard_c(&cellCopy);
+	endpoints.reserve(2 * count);
+
 	for(long i = 0; i < count; i++)
 	{
 		double start, end;
 
 		wnfetd_c(&cellCopy, i, &start, &end);
 
-		intervals.push_back(Interval(start, end));
+		endpoints.push_back(start);
+		endpoints.push_back(end);
+	}
+
+	if(failed_c())
+		CSpiceUtil::SignalError("Window conversion failed");
+}
+
+Window::Window(const std::vector<double>& endpoints) : endpoints(endpoints)
+{
+
+}
+
+void Window::Insert(double left, double right)
+{
+	if(left > right)
+		CSpiceUtil::SignalError("Window::Insert: left endpoint is greater than right one");
+
+	// Intervals [first, last) overlap or touch the new one and are merged with it
+	size_t first = (std::lower_bound(endpoints.begin(), endpoints.end(), left) - endpoints.begin()) / 2;
+	size_t last = (std::upper_bound(endpoints.begin(), endpoints.end(), right) - endpoints.begin() + 1) / 2;
+
+	if(first < last)
+	{
+		left = std::min(left, endpoints[2 * first]);
+		right = std::max(right, endpoints[2 * last - 1]);
+	}
+
+	endpoints.erase(endpoints.begin() + 2 * first, endpoints.begin() + 2 * last);
+
+	double interval[2] = { left, right };
+	endpoints.insert(endpoints.begin() + 2 * first, interval, interval + 2);
+}
+
+void Window::Insert(const Interval& interval)
+{
+	Insert(interval.GetLeft(), interval.GetRight());
+}
+
+size_t Window::GetIntervalCount() const
+{
+	return endpoints.size() / 2;
+}
+
+std::vector<Interval> Window::GetIntervals() const
+{
+	std::vector<Interval> intervals;
+	intervals.reserve(GetIntervalCount());
+
+	for(size_t i = 0; i < endpoints.size(); i += 2)
+	{
+		intervals.push_back(Interval(endpoints[i], endpoints[i + 1]));
 	}
 
 	return intervals;
 }
 
+const std::vector<double>& Window::GetEndpoints() const
+{
+	return endpoints;
+}
+
 bool Window::IsIncluded(double point) const
 {
-	return IsIncluded(point, point);
+	return FindInterval(point) >= 0;
 }
 
 bool Window::IsIncluded(double left, double right) const
 {
-	SpiceCell cellCopy = cell;
-	SpiceBoolean isIncluded = wnincd_c(left, right, &cellCopy);
+	if(left > right)
+		return false;
 
-	if(failed_c())
-		CSpiceUtil::SignalError("Include test failed");
+	long idx = FindInterval(left);
 
-	return isIncluded != SPICEFALSE;
+	return idx >= 0 && right <= endpoints[2 * idx + 1];
 }
 
 bool Window::IsIncluded(const Interval& interval) const
@@ -56,7 +147,253 @@ bool Window::IsIncluded(const Interval& interval) const
 	return IsIncluded(interval.GetLeft(), interval.GetRight());
 }
 
-SpiceCell& Window::GetSpiceCell()
+void Window::IsIncluded(const std::vector<double>& points, std::vector<bool>& mask) const
 {
-	return cell;
+	mask.assign(points.size(), false);
+
+	std::vector<std::pair<size_t, size_t>> ranges = GetIncludedRanges(points);
+
+	for(size_t i = 0; i < ranges.size(); i++)
+		std::fill(mask.begin() + ranges[i].first, mask.begin() + ranges[i].second, true);
+}
+
+std::vector<std::pair<size_t, size_t>> Window::GetIncludedRanges(const std::vector<double>& points) const
+{
+	if(!std::is_sorted(points.begin(), points.end()))
+		CSpiceUtil::SignalError("Window::GetIncludedRanges: points are not sorted");
+
+	std::vector<std::pair<size_t, size_t>> ranges;
+
+	size_t p = 0;
+	size_t i = 0;
+
+	while(p < points.size() && i < endpoints.size())
+	{
+		if(points[p] < endpoints[i])
+		{
+			p++;
+		}
+		else if(points[p] > endpoints[i + 1])
+		{
+			i += 2;
+		}
+		else
+		{
+			// Consume every point inside the current interval
+			size_t first = p;
+			while(p < points.size() && points[p] <= endpoints[i + 1])
+				p++;
+
+			ranges.push_back(std::make_pair(first, p));
+			i += 2;
+		}
+	}
+
+	return ranges;
+}
+
+Window Window::Union(const Window& other) const
+{
+	const std::vector<double>& a = endpoints;
+	const std::vector<double>& b = other.endpoints;
+
+	Window result;
+	std::vector<double>& out = result.endpoints;
+	out.reserve(a.size() + b.size());
+
+	size_t i = 0;
+	size_t j = 0;
+
+	// Take intervals in order of their left endpoint
+	while(i < a.size() || j < b.size())
+	{
+		double left, right;
+
+		if(j >= b.size() || (i < a.size() && a[i] <= b[j]))
+		{
+			left = a[i];
+			right = a[i + 1];
+			i += 2;
+		}
+		else
+		{
+			left = b[j];
+			right = b[j + 1];
+			j += 2;
+		}
+
+		AppendMerged(out, left, right);
+	}
+
+	return result;
+}
+
+Window Window::Intersection(const Window& other) const
+{
+	const std::vector<double>& a = endpoints;
+	const std::vector<double>& b = other.endpoints;
+
+	Window result;
+	std::vector<double>& out = result.endpoints;
+	out.reserve(a.size() + b.size());
+
+	size_t i = 0;
+	size_t j = 0;
+
+	while(i < a.size() && j < b.size())
+	{
+		double left = std::max(a[i], b[j]);
+		double right = std::min(a[i + 1], b[j + 1]);
+
+		if(left <= right)
+		{
+			out.push_back(left);
+			out.push_back(right);
+		}
+
+		// Whichever interval ends first can't meet anything further on the other side
+		if(a[i + 1] < b[j + 1])
+			i += 2;
+		else
+			j += 2;
+	}
+
+	return result;
+}
+
+Window Window::Difference(const Window& other) const
+{
+	const std::vector<double>& a = endpoints;
+	const std::vector<double>& b = other.endpoints;
+
+	Window result;
+	std::vector<double>& out = result.endpoints;
+	out.reserve(a.size() + b.size());
+
+	size_t j = 0;
+
+	for(size_t i = 0; i < a.size(); i += 2)
+	{
+		double cursor = a[i];
+		double right = a[i + 1];
+		bool removed = false;
+
+		// Skip intervals of other ending before this one starts
+		while(j < b.size() && b[j + 1] < cursor)
+			j += 2;
+
+		// Intervals of other reaching past this one are kept for the next
+		size_t k = j;
+		for(; k < b.size() && b[k] <= right; k += 2)
+		{
+			if(b[k] > cursor)
+				AppendMerged(out, cursor, b[k]);
+
+			cursor = std::max(cursor, b[k + 1]);
+			removed = true;
+		}
+
+		if(!removed || cursor < right)
+			AppendMerged(out, cursor, right);
+	}
+
+	return result;
+}
+
+Window Window::Complement(double left, double right) const
+{
+	if(left > right)
+		CSpiceUtil::SignalError("Window::Complement: left endpoint is greater than right one");
+
+	Window range;
+	range.endpoints.push_back(left);
+	range.endpoints.push_back(right);
+
+	return range.Difference(*this);
+}
+
+Window Window::Expand(double left, double right) const
+{
+	Window result;
+	std::vector<double>& out = result.endpoints;
+	out.reserve(endpoints.size());
+
+	// Shifting keeps the order of left endpoints, so one pass both drops inverted intervals and merges overlaps
+	for(size_t i = 0; i < endpoints.size(); i += 2)
+	{
+		double l = endpoints[i] - left;
+		double r = endpoints[i + 1] + right;
+
+		if(l > r)
+			continue;
+
+		AppendMerged(out, l, r);
+	}
+
+	return result;
+}
+
+Window Window::Contract(double left, double right) const
+{
+	return Expand(-left, -right);
+}
+
+Window Window::Filter(double minLength) const
+{
+	Window result;
+	std::vector<double>& out = result.endpoints;
+	out.reserve(endpoints.size());
+
+	// Like wnfltd_c, intervals not longer than minLength are removed
+	for(size_t i = 0; i < endpoints.size(); i += 2)
+	{
+		if(endpoints[i + 1] - endpoints[i] > minLength)
+		{
+			out.push_back(endpoints[i]);
+			out.push_back(endpoints[i + 1]);
+		}
+	}
+
+	return result;
+}
+
+WindowCell Window::ToSpiceCell(size_t extraCapacity) const
+{
+	WindowCell windowCell(endpoints.size() + 2 * extraCapacity);
+	SpiceCell& cell = windowCell.GetSpiceCell();
+
+	std::copy(endpoints.begin(), endpoints.end(), (double*)cell.data);
+	cell.card = (SpiceInt)endpoints.size();
+
+	return windowCell;
+}
+
+void Window::AppendMerged(std::vector<double>& out, double left, double right)
+{
+	// Pieces come in order of their left endpoint, closed intervals that overlap or touch become one
+	if(!out.empty() && left <= out.back())
+	{
+		if(right > out.back())
+			out.back() = right;
+	}
+	else
+	{
+		out.push_back(left);
+		out.push_back(right);
+	}
+}
+
+long Window::FindInterval(double point) const
+{
+	std::vector<double>::const_iterator it = std::lower_bound(endpoints.begin(), endpoints.end(), point);
+	if(it == endpoints.end())
+		return -1;
+
+	// Landing on a right endpoint means the left one is below the point, intervals are closed
+	size_t idx = it - endpoints.begin();
+
+	if(idx % 2 == 1 || *it == point)
+		return (long)(idx / 2);
+
+	return -1;
 }
@@ -4,8 +4,7 @@
 #include "Time.h"
 
 #include <vector>
-
-#define WINDOW_MAX_INTERVALS 1024
+#include <utility>
 
 struct Interval
 {
@@ -40,20 +39,62 @@ private:
 	double right;
 };
 
+// Heap backed double precision SpiceCell, used to hand windows over to CSpice
+class WindowCell
+{
+public:
+	WindowCell(size_t capacity);
+	WindowCell(const WindowCell& other);
+	WindowCell& operator=(const WindowCell& other);
+
+	SpiceCell& GetSpiceCell();
+
+private:
+	void Bind(size_t capacity, long card);
+
+private:
+	std::vector<double> storage;
+	SpiceCell cell;
+};
+
 class Window
 {
 public:
 	Window();
-	Window(SpiceCell cell);
+	explicit Window(const SpiceCell& cell);
+	explicit Window(const std::vector<double>& endpoints); // already sorted and disjoint [left, right] pairs
+
+	void Insert(double left, double right);
+	void Insert(const Interval& interval);
 
+	size_t GetIntervalCount() const;
 	std::vector<Interval> GetIntervals() const;
+	const std::vector<double>& GetEndpoints() const;
 
 	bool IsIncluded(double point) const;
 	bool IsIncluded(double left, double right) const;
 	bool IsIncluded(const Interval& interval) const;
 
-	SpiceCell& GetSpiceCell();
+	// Batch membership of ascending points, in one merge walk over points and intervals
+	void IsIncluded(const std::vector<double>& points, std::vector<bool>& mask) const;
+	std::vector<std::pair<size_t, size_t>> GetIncludedRanges(const std::vector<double>& points) const; // [first, last) index ranges
+
+	// Set algebra, linear merges over the endpoint arrays with the same closed interval semantics as the wn*d_c routines
+	Window Union(const Window& other) const;
+	Window Intersection(const Window& other) const;
+	Window Difference(const Window& other) const;
+	Window Complement(double left, double right) const;
+
+	Window Expand(double left, double right) const;
+	Window Contract(double left, double right) const;
+	Window Filter(double minLength) const;
+
+	WindowCell ToSpiceCell(size_t extraCapacity = 0) const;
 
 private:
-	SpiceCell cell;
-};
\ No newline at end of file
+	static void AppendMerged(std::vector<double>& out, double left, double right);
+	long FindInterval(double point) const;
+
+private:
+	std::vector<double> endpoints;
+};
@@ -0,0 +1,145 @@
+#include "../CSpice/CSpiceUtil.h"
+#include "../CSpice/TimeConversion.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+// Native UTC to ET conversion checked against str2et_c over data/meta.tm, exits with 1 on any failure
+
+#define TIME_CHECK_TOLERANCE 1e-6
+#define TIME_CHECK_SAMPLES_PER_INTERVAL 64
+
+struct ReferenceEpoch
+{
+	const char* utc;
+	double et;
+};
+
+static const ReferenceEpoch referenceEpochs[] =
+{
+	{ "2000-01-01T12:00:00", 64.183927284731 },
+	{ "2016-12-31T23:59:60", 536500868.183929801 },
+	{ "2016-12-31T23:59:60.5", 536500868.683929801 },
+	{ "2017-01-01T00:00:00", 536500869.183929801 },
+};
+
+static std::string FormatIso(long days, double timeOfDay)
+{
+	int year, month, day;
+	TimeConversion::CivilFromDays(days, year, month, day);
+
+	// A time of day past 86400 is written as the 61st second of the last minute
+	int hour = (timeOfDay >= SECONDS_PER_DAY) ? 23 : (int)(timeOfDay / 3600.0);
+	int minute = (timeOfDay >= SECONDS_PER_DAY) ? 59 : (int)(timeOfDay / 60.0) % 60;
+	double second = timeOfDay - 3600.0 * hour - 60.0 * minute;
+
+	char str[64];
+	std::snprintf(str, sizeof(str), "%04d-%02d-%02dT%02d:%02d:%09.6f", year, month, day, hour, minute, std::floor(second * 1e6) / 1e6);
+
+	return std::string(str);
+}
+
+// Both sides of every TAI-UTC change, inserted leap seconds and epochs spread over each interval, the last one taken as ten years long
+static void GetSweepEpochs(const LeapSecondTable& lsk, std::vector<std::string>& strs)
+{
+	const std::vector<double>& epochs = lsk.epochs;
+	const std::vector<double>& offsets = lsk.offsets;
+
+	for(size_t i = 0; i < epochs.size(); i++)
+	{
+		long firstDay = (long)std::floor((epochs[i] + 0.5 * SECONDS_PER_DAY) / SECONDS_PER_DAY) + UNIX_DAYS_AT_J2000;
+		long lastDay = (i + 1 < epochs.size()) ? (long)std::floor((epochs[i + 1] + 0.5 * SECONDS_PER_DAY) / SECONDS_PER_DAY) + UNIX_DAYS_AT_J2000 : firstDay + 3653;
+
+		strs.push_back(FormatIso(firstDay, 0.0));
+		if(i > 0)
+			strs.push_back(FormatIso(firstDay - 1, SECONDS_PER_DAY - 0.5e-6));
+		if(i > 0 && offsets[i] > offsets[i - 1])
+			strs.push_back(FormatIso(firstDay - 1, SECONDS_PER_DAY + 0.5));
+
+		// Odd step, so every time of day gets some fraction of a second
+		for(size_t k = 1; k < TIME_CHECK_SAMPLES_PER_INTERVAL; k++)
+		{
+			double position = (double)k / TIME_CHECK_SAMPLES_PER_INTERVAL * (lastDay - firstDay);
+			long day = firstDay + (long)position;
+
+			strs.push_back(FormatIso(day, std::fmod(k * 7919.123457, SECONDS_PER_DAY)));
+		}
+	}
+}
+
+static bool CheckEpoch(const char* str, const double* expected, double& maxDifference)
+{
+	double native;
+	double reference;
+
+	if(!TimeConversion::TryUtcToEt(str, native))
+	{
+		std::cout << str << ": not converted natively" << std::endl;
+		return false;
+	}
+
+	CSPICE_ASSERT(str2et_c(str, &reference));
+
+	double difference = std::fabs(native - reference);
+	maxDifference = std::max(maxDifference, difference);
+
+	bool passed = difference <= TIME_CHECK_TOLERANCE;
+	if(!passed)
+		std::cout << str << ": native " << native << ", str2et_c " << reference << std::endl;
+
+	if(expected != nullptr && std::fabs(native - *expected) > TIME_CHECK_TOLERANCE)
+	{
+		std::cout << str << ": native " << native << ", expected " << *expected << std::endl;
+		passed = false;
+	}
+
+	return passed;
+}
+
+int main()
+{
+	std::cout.precision(17);
+
+	try
+	{
+		CSpiceUtil::LoadKernel("data/meta.tm");
+
+		const LeapSecondTable* lsk = TimeConversion::GetLeapSecondTable();
+		if(lsk == nullptr)
+			CSpiceUtil::SignalError("TimeCheck: no leap second kernel in data/meta.tm");
+
+		size_t failures = 0;
+		double maxDifference = 0.0;
+
+		size_t referenceCount = sizeof(referenceEpochs) / sizeof(referenceEpochs[0]);
+		for(size_t i = 0; i < referenceCount; i++)
+		{
+			if(!CheckEpoch(referenceEpochs[i].utc, &referenceEpochs[i].et, maxDifference))
+				failures++;
+		}
+
+		std::vector<std::string> strs;
+		GetSweepEpochs(*lsk, strs);
+
+		for(size_t i = 0; i < strs.size(); i++)
+		{
+			if(!CheckEpoch(strs[i].c_str(), nullptr, maxDifference))
+				failures++;
+		}
+
+		std::cout << referenceCount + strs.size() << " epochs, largest difference to str2et_c " << maxDifference << " s, " << failures << " failed" << std::endl;
+
+		return failures == 0 ? 0 : 1;
+	}
+	catch(const std::exception& ex)
+	{
+		std::cout << "Error encountered:" << std::endl;
+		std::cout << ex.what() << std::endl;
+
+		return 1;
+	}
+}
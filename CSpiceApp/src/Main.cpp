@@ -37,16 +37,20 @@ int main()
 
 		app.LoadSolarSystem(true);
 
-		std::vector<KernelData> kernels = CSpiceUtil::GetLoadedKernels();
+		const std::vector<KernelData>& kernels = CSpiceUtil::GetLoadedKernels();
 
 		fout << "Loaded kernels:" << std::endl;
 		for(size_t i = 0; i < kernels.size(); i++)
 		{
-			KernelData kData = kernels[i];
+			const KernelData& kData = kernels[i];
 			fout << "\t" << kData.filename << " (" << kData.type << ")" << std::endl;
 		}
 		fout << std::endl;
 
+		// Compiled once, all endpoints of a window are formatted in one batch with string i at i * stride
+		DateFormat dateFormat(DATE_DEFAULT_FORMAT);
+		size_t stride = dateFormat.GetMaxLength() + 1;
+
 		size_t objectsCount = app.GetObjectsLength();
 		for(size_t i = 0; i < objectsCount; i++)
 		{
@@ -94,23 +98,22 @@ int main()
 				fout << "\t\tObject does not contain any state data" << std::endl;
 			}
 
+			std::vector<char> spkEndpoints(spkCoverage.GetEndpoints().size() * stride);
+			dateFormat.Format(spkCoverage.GetEndpoints(), spkEndpoints.data(), stride);
+
 			for(size_t i = 0; i < spkIntervals.size(); i++)
 			{
-				Interval interval = spkIntervals[i];
-
-				Date begin(interval.GetLeft());
-				Date end(interval.GetRight());
-
-				fout << "\t\t" << begin.AsString() << " - " << end.AsString() << std::endl;
+				fout << "\t\t" << &spkEndpoints[2 * i * stride] << " - " << &spkEndpoints[(2 * i + 1) * stride] << std::endl;
 			}
 			fout << std::endl;
 
 			fout << "\t" << t.AsString() << " relative to " << app.GetReferenceFrame().GetName() << ":" << std::endl;
 
-			if(spkCoverage.IsIncluded(t.AsDouble()))
+			if(obj.IsCovered(t))
 			{
-				Vector3T<Length> pos = obj.GetPosition(t, app.GetReferenceFrame());
-				Vector3T<Velocity> vel = obj.GetVelocity(t, app.GetReferenceFrame());
+				StateVector state = obj.GetState(t, app.GetReferenceFrame());
+				const Vector3T<Length>& pos = state.position;
+				const Vector3T<Velocity>& vel = state.velocity;
 
 				fout << "\t\tPos: " << pos.Length().ValueIn(app.LengthUnit()) << " (" << pos.x.ValueIn(app.LengthUnit()) << ", " << pos.y.ValueIn(app.LengthUnit()) << ", " << pos.z.ValueIn(app.LengthUnit()) << ") " << app.LengthUnit().str() << std::endl;
 				fout << "\t\tVel: " << vel.Length().ValueIn(app.VelocityUnit()) << " (" << vel.x.ValueIn(app.VelocityUnit()) << ", " << vel.y.ValueIn(app.VelocityUnit()) << ", " << vel.z.ValueIn(app.VelocityUnit()) << ") " << app.VelocityUnit().str() << std::endl;
@@ -150,14 +153,12 @@ int main()
 								fout << "\t\tObject does not contain any orientation data" << std::endl;
 							}
 
+							std::vector<char> pckEndpoints(pckCoverage.GetEndpoints().size() * stride);
+							dateFormat.Format(pckCoverage.GetEndpoints(), pckEndpoints.data(), stride);
+
 							for(size_t i = 0; i < pckIntervals.size(); i++)
 							{
-								Interval interval = pckIntervals[i];
-
-								Date begin(interval.GetLeft());
-								Date end(interval.GetRight());
-
-								fout << "\t\t" << begin.AsString() << " - " << end.AsString() << std::endl;
+								fout << "\t\t" << &pckEndpoints[2 * i * stride] << " - " << &pckEndpoints[(2 * i + 1) * stride] << std::endl;
 							}
 							fout << std::endl;
 						}
@@ -170,9 +171,9 @@ int main()
 
 						if(dataAvailableAtT)
 						{
-							Vector3 axisX = bodyFrame.AxisX(t, app.GetReferenceFrame());
-							Vector3 axisY = bodyFrame.AxisY(t, app.GetReferenceFrame());
-							Vector3 axisZ = bodyFrame.AxisZ(t, app.GetReferenceFrame());
+							Vector3d axisX = bodyFrame.AxisX(t, app.GetReferenceFrame());
+							Vector3d axisY = bodyFrame.AxisY(t, app.GetReferenceFrame());
+							Vector3d axisZ = bodyFrame.AxisZ(t, app.GetReferenceFrame());
 
 							fout << "\t\tX axis: (" << axisX.x << ", " << axisX.y << ", " << axisX.z << ")" << std::endl;
 							fout << "\t\tY axis: (" << axisY.x << ", " << axisY.y << ", " << axisY.z << ")" << std::endl;
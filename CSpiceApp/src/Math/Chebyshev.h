@@ -0,0 +1,44 @@
+#pragma once
+
+// Chebyshev expansions as stored in SPK/PCK type 2 and 3 records.
+// Coefficients are ordered by increasing degree, s is the normalised argument in [-1, 1]
+
+inline double ChebyshevValue(const double* coeffs, int count, double s)
+{
+	double twoS = 2.0 * s;
+	double b1 = 0.0;
+	double b2 = 0.0;
+
+	for(int k = count - 1; k > 0; k--)
+	{
+		double b0 = twoS * b1 - b2 + coeffs[k];
+		b2 = b1;
+		b1 = b0;
+	}
+
+	return s * b1 - b2 + coeffs[0];
+}
+
+// Clenshaw recurrence for the value and its derivative with respect to s in a single pass
+inline void ChebyshevValueDerivative(const double* coeffs, int count, double s, double& value, double& derivative)
+{
+	double twoS = 2.0 * s;
+	double b1 = 0.0;
+	double b2 = 0.0;
+	double db1 = 0.0;
+	double db2 = 0.0;
+
+	for(int k = count - 1; k > 0; k--)
+	{
+		double b0 = twoS * b1 - b2 + coeffs[k];
+		double db0 = twoS * db1 - db2 + 2.0 * b1;
+
+		b2 = b1;
+		b1 = b0;
+		db2 = db1;
+		db1 = db0;
+	}
+
+	value = s * b1 - b2 + coeffs[0];
+	derivative = s * db1 - db2 + b1;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Vector3d.h"
+
+#include <cstring>
+
+// Double precision 3x3 matrix, row-major and laid out like the SpiceDouble[3][3] of CSpice
+class MATH_ALIGN(32) Matrix3d
+{
+public:
+	Matrix3d()
+	{
+		std::memset(m, 0, sizeof(m));
+	}
+	explicit Matrix3d(const double matrix[3][3])
+	{
+		std::memcpy(m, matrix, sizeof(m));
+	}
+
+	// Unchecked element access for inner loops
+	double operator()(size_t row, size_t col) const
+	{
+		return m[row][col];
+	}
+	double& operator()(size_t row, size_t col)
+	{
+		return m[row][col];
+	}
+
+	double (*GetData())[3]
+	{
+		return m;
+	}
+	const double (*GetData() const)[3]
+	{
+		return m;
+	}
+	void CopyTo(double matrix[3][3]) const
+	{
+		std::memcpy(matrix, m, sizeof(m));
+	}
+
+	Vector3d GetRow(size_t row) const
+	{
+		return Vector3d(m[row]);
+	}
+	Vector3d GetColumn(size_t col) const
+	{
+		return Vector3d(m[0][col], m[1][col], m[2][col]);
+	}
+
+	Matrix3d Transposed() const
+	{
+		Matrix3d res;
+		for(int row = 0; row < 3; row++)
+		{
+			for(int col = 0; col < 3; col++)
+				res.m[row][col] = m[col][row];
+		}
+
+		return res;
+	}
+
+	Vector3d operator*(const Vector3d& v) const
+	{
+		return Vector3d(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+						m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+						m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+	}
+
+	// Transpose of this matrix times v, the inverse rotation
+	Vector3d TransposeMultiply(const Vector3d& v) const
+	{
+		return Vector3d(m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z,
+						m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z,
+						m[0][2] * v.x + m[1][2] * v.y + m[2][2] * v.z);
+	}
+
+	Matrix3d operator*(const Matrix3d& rhs) const
+	{
+		Matrix3d res;
+		for(int row = 0; row < 3; row++)
+		{
+			for(int col = 0; col < 3; col++)
+				res.m[row][col] = m[row][0] * rhs.m[0][col] + m[row][1] * rhs.m[1][col] + m[row][2] * rhs.m[2][col];
+		}
+
+		return res;
+	}
+
+	// Transpose of this matrix times rhs
+	Matrix3d TransposeMultiply(const Matrix3d& rhs) const
+	{
+		Matrix3d res;
+		for(int row = 0; row < 3; row++)
+		{
+			for(int col = 0; col < 3; col++)
+				res.m[row][col] = m[0][row] * rhs.m[0][col] + m[1][row] * rhs.m[1][col] + m[2][row] * rhs.m[2][col];
+		}
+
+		return res;
+	}
+
+	static Matrix3d Identity()
+	{
+		Matrix3d res;
+		res.m[0][0] = 1.0;
+		res.m[1][1] = 1.0;
+		res.m[2][2] = 1.0;
+
+		return res;
+	}
+
+private:
+	double m[3][3];
+};
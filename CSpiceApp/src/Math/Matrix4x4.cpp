@@ -60,34 +60,18 @@ float Matrix4x4::Get(size_t row, size_t col) const
 
 void Matrix4x4::GetRowMajor(float* m) const
 {
-	//std::memcpy(m, matrix, DIM * DIM * sizeof(float));
-
-	float res[DIM*DIM];
-
-	for(size_t row = 0; row < DIM; row++)
-	{
-		for(size_t col = 0; col < DIM; col++)
-		{
-			res[row * DIM + col] = Get(row, col);
-		}
-	}
-
-	std::memcpy(m, res, DIM*DIM*sizeof(float));
+	std::memcpy(m, matrix, DIM * DIM * sizeof(float));
 }
 
 void Matrix4x4::GetColumnMajor(float* m) const
 {
-	float res[DIM*DIM];
-
 	for(size_t col = 0; col < DIM; col++)
 	{
 		for(size_t row = 0; row < DIM; row++)
 		{
-			res[col * DIM + row] = Get(row, col);
+			m[col * DIM + row] = matrix[row][col];
 		}
 	}
-
-	std::memcpy(m, res, DIM*DIM*sizeof(float));
 }
 
 bool Matrix4x4::IsRowColCorrect(size_t row, size_t col) const
@@ -1,4 +1,11 @@
 #include "Quantity.h"
+#include "Vector3T.h"
+
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<Length>::value, "Quantity must stay a plain double");
+static_assert(std::is_trivially_copyable<Vector3T<Length>>::value, "Vector3T of quantities must stay plain doubles");
+static_assert(sizeof(Vector3T<Length>) == 3 * sizeof(double), "Vector3T of quantities must stay plain doubles");
 
 double powi(double val, int exp)
 {
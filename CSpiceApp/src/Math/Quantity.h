@@ -1,10 +1,11 @@
 #pragma once
 
 #include <cmath>
-#include <string>
 
 double powi(double val, int exp);
 
+// Units are only scale factors to the base units (m, s, kg) plus a display label.
+// Labels are expected to be string literals, so units stay trivially copyable and never allocate.
 template<int length, int time, int mass>
 class Unit
 {
@@ -15,15 +16,15 @@ class Unit
 	typedef Unit<0, 1, 0> TimeUnit;
 
 public:
-	static ThisUnit BaseUnit(const std::string& label = "")
+	static ThisUnit BaseUnit(const char* label = "")
 	{
 		return ThisUnit(label);
 	}
-	static ThisUnit ScaledUnit(double multiplier, const ThisUnit& ref = ThisUnit(), const std::string& label = "")
+	static ThisUnit ScaledUnit(double multiplier, const ThisUnit& ref = ThisUnit(), const char* label = "")
 	{
 		return ThisUnit(multiplier, ref, label);
 	}
-	static ThisUnit DerivedUnit(const LengthUnit& lengthUnit, const TimeUnit& timeUnit, const MassUnit& massUnit, const std::string& label = "")
+	static ThisUnit DerivedUnit(const LengthUnit& lengthUnit, const TimeUnit& timeUnit, const MassUnit& massUnit, const char* label = "")
 	{
 		double totalMultiplier = 1.0;
 
@@ -33,15 +34,15 @@ public:
 
 		return ThisUnit(totalMultiplier, label);
 	}
-	static ThisUnit DerivedUnit(const LengthUnit& lengthUnit, const TimeUnit& timeUnit, const std::string& label = "")
+	static ThisUnit DerivedUnit(const LengthUnit& lengthUnit, const TimeUnit& timeUnit, const char* label = "")
 	{
 		return DerivedUnit(lengthUnit, timeUnit, MassUnit::BaseUnit(), label);
 	}
-	static ThisUnit DerivedUnit(const TimeUnit& timeUnit, const MassUnit& massUnit, const std::string& label = "")
+	static ThisUnit DerivedUnit(const TimeUnit& timeUnit, const MassUnit& massUnit, const char* label = "")
 	{
 		return DerivedUnit(LengthUnit::BaseUnit(), timeUnit, massUnit, label);
 	}
-	static ThisUnit DerivedUnit(const LengthUnit& lengthUnit, const MassUnit& massUnit, const std::string& label = "")
+	static ThisUnit DerivedUnit(const LengthUnit& lengthUnit, const MassUnit& massUnit, const char* label = "")
 	{
 		return DerivedUnit(lengthUnit, TimeUnit::BaseUnit(), massUnit, label);
 	}
@@ -50,22 +51,20 @@ public:
 	//	return DerivedUnit(LengthUnit::BaseUnit(), TimeUnit::BaseUnit(), massUnit, label);
 	//}
 
-	Unit(const std::string& label = "") // constructs base unit
+	Unit(const char* label = "") : multiplier(1.0), label(label) // constructs base unit
 	{
-		Construct(1.0, label);
+
 	}
 
 private:
-	Unit(double multiplier, const std::string& label)
+	Unit(double multiplier, const char* label) : multiplier(multiplier), label(label)
 	{
-		Construct(multiplier, label);
+
 	}
 
-	Unit(double multiplier, const ThisUnit& ref, const std::string& label)
+	Unit(double multiplier, const ThisUnit& ref, const char* label) : multiplier(multiplier * ref.GetMultiplier()), label(label)
 	{
-		double rmultiplier = ref.GetMultiplier();
 
-		Construct(multiplier * rmultiplier, label);
 	}
 
 public:
@@ -74,12 +73,12 @@ public:
 		return multiplier;
 	}
 
-	void SetLabel(const std::string& label)
+	void SetLabel(const char* label)
 	{
 		this->label = label;
 	}
 
-	const std::string& str() const
+	const char* str() const
 	{
 		return this->label;
 	}
@@ -92,18 +91,13 @@ public:
 		return value * (fmultiplier / tmultiplier);
 	}
 
-private:
-	void Construct(double multiplier, const std::string& label)
-	{
-		this->multiplier = multiplier;
-		this->label = label;
-	}
-
 private:
 	double multiplier;
-	std::string label;
+	const char* label;
 };
 
+// A quantity is a single double in base units, the dimension lives in the type only.
+// Trivially copyable, so arrays of quantities can be copied and processed as plain doubles.
 template<int length, int time, int mass>
 class Quantity
 {
@@ -111,33 +105,44 @@ class Quantity
 	typedef Quantity<length, time, mass> ThisQuantity;
 
 public:
-	Quantity()
+	typedef CurrentUnit UnitType;
+
+public:
+	Quantity() : value(0.0)
+	{
+
+	}
+	Quantity(double value, const CurrentUnit& unit) : value(value * unit.GetMultiplier())
 	{
-		Construct(0.0, CurrentUnit::BaseUnit());
+
 	}
-	Quantity(double value, const CurrentUnit& unit)
+
+	static ThisQuantity FromBase(double value)
 	{
-		Construct(value, unit);
+		ThisQuantity res;
+		res.value = value;
+
+		return res;
 	}
 
 	double ValueIn(const CurrentUnit& ref) const
 	{
-		return Unit<length, time, mass>::Convert(value, unit, ref);
+		return value / ref.GetMultiplier();
 	}
 	double ValueInBase() const
 	{
-		return ValueIn(CurrentUnit::BaseUnit());
+		return value;
 	}
 
 	ThisQuantity& operator+=(const ThisQuantity& rhs)
 	{
-		value += rhs.ValueIn(unit);
+		value += rhs.value;
 
 		return *this;
 	}
 	ThisQuantity& operator-=(const ThisQuantity& rhs)
 	{
-		value -= rhs.ValueIn(unit);
+		value -= rhs.value;
 
 		return *this;
 	}
@@ -148,53 +153,53 @@ public:
 		return *this;
 	}
 
-private:
-	void Construct(double value, const CurrentUnit& unit)
-	{
-		this->value = value;
-		this->unit = unit;
-	}
-
 private:
 	double value;
-	CurrentUnit unit;
 
 	friend Quantity operator+(const Quantity& lhs, const Quantity& rhs)
 	{
-		double newValue = lhs.value + rhs.ValueIn(lhs.unit);
-
-		return Quantity(newValue, lhs.unit);
+		return FromBase(lhs.value + rhs.value);
 	}
 	friend Quantity operator-(const Quantity& op)
 	{
-		return (-1.0) * op;
+		return FromBase(-op.value);
 	}
 	friend Quantity operator-(const Quantity& lhs, const Quantity& rhs)
 	{
-		return lhs + (-rhs);
+		return FromBase(lhs.value - rhs.value);
 	}
 	friend Quantity operator*(const Quantity& lhs, double rhs)
 	{
-		return Quantity(lhs.value * rhs, lhs.unit);
+		return FromBase(lhs.value * rhs);
 	}
 	friend Quantity operator*(double lhs, const Quantity& rhs)
 	{
-		return rhs * lhs;
+		return FromBase(lhs * rhs.value);
+	}
+	friend Quantity operator/(const Quantity& lhs, double rhs)
+	{
+		return FromBase(lhs.value / rhs);
 	}
 	friend double operator/(const Quantity& lhs, const Quantity& rhs)
 	{
-		return lhs.value / rhs.ValueIn(lhs.unit);
+		return lhs.value / rhs.value;
 	}
 	friend bool operator>(const Quantity& lhs, const Quantity& rhs)
 	{
-		return lhs.ValueInBase() > rhs.ValueInBase();
+		return lhs.value > rhs.value;
 	}
 	friend bool operator<(const Quantity& lhs, const Quantity& rhs)
 	{
-		return lhs.ValueInBase() < rhs.ValueInBase();
+		return lhs.value < rhs.value;
 	}
 };
 
+// Products of quantities carry the sum of the dimensions, e.g. Length * Velocity
+template<int length1, int time1, int mass1, int length2, int time2, int mass2>
+Quantity<length1 + length2, time1 + time2, mass1 + mass2> operator*(const Quantity<length1, time1, mass1>& lhs, const Quantity<length2, time2, mass2>& rhs)
+{
+	return Quantity<length1 + length2, time1 + time2, mass1 + mass2>::FromBase(lhs.ValueInBase() * rhs.ValueInBase());
+}
 
 typedef Quantity<1, 0, 0> Length;
 typedef Quantity<0, 1, 0> Time;
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "Quantity.h"
+#include "Vector3T.h"
+#include "Vec3Array.h"
+#include "../CSpice/CSpiceUtil.h"
+
+#include <vector>
+#include <cmath>
+#include <cstring>
+
+// Contiguous quantities of one dimension, stored as plain doubles in base units.
+// Conversions are a single scaled copy, kernels are simple loops the compiler can vectorize.
+template<typename Q>
+class QuantityArray
+{
+public:
+	typedef typename Q::UnitType UnitType;
+
+public:
+	QuantityArray()
+	{
+
+	}
+	explicit QuantityArray(size_t count) : values(count, 0.0)
+	{
+
+	}
+
+	void Resize(size_t count)
+	{
+		values.resize(count);
+	}
+	size_t Size() const
+	{
+		return values.size();
+	}
+
+	Q Get(size_t i) const
+	{
+		return Q::FromBase(values[i]);
+	}
+	void Set(size_t i, const Q& q)
+	{
+		values[i] = q.ValueInBase();
+	}
+
+	// Values in base units
+	double* Data()
+	{
+		return values.data();
+	}
+	const double* Data() const
+	{
+		return values.data();
+	}
+
+	void Assign(const double* source, size_t count, const UnitType& unit)
+	{
+		values.resize(count);
+		Scale(source, count, unit.GetMultiplier(), values.data());
+	}
+
+	void ConvertTo(const UnitType& unit, double* out) const
+	{
+		Scale(values.data(), values.size(), 1.0 / unit.GetMultiplier(), out);
+	}
+	std::vector<double> ValuesIn(const UnitType& unit) const
+	{
+		std::vector<double> out(values.size());
+		ConvertTo(unit, out.data());
+
+		return out;
+	}
+
+	QuantityArray& operator+=(const QuantityArray& rhs)
+	{
+		if(rhs.values.size() != values.size())
+			CSpiceUtil::SignalError("QuantityArray::operator+=: element counts differ");
+
+		double* v = values.data();
+		const double* r = rhs.values.data();
+
+		for(size_t i = 0; i < values.size(); i++)
+			v[i] += r[i];
+
+		return *this;
+	}
+	QuantityArray& operator-=(const QuantityArray& rhs)
+	{
+		if(rhs.values.size() != values.size())
+			CSpiceUtil::SignalError("QuantityArray::operator-=: element counts differ");
+
+		double* v = values.data();
+		const double* r = rhs.values.data();
+
+		for(size_t i = 0; i < values.size(); i++)
+			v[i] -= r[i];
+
+		return *this;
+	}
+	QuantityArray& operator*=(double rhs)
+	{
+		Scale(values.data(), values.size(), rhs, values.data());
+
+		return *this;
+	}
+
+	static void Scale(const double* source, size_t count, double factor, double* out)
+	{
+		if(factor == 1.0)
+		{
+			if(out != source && count > 0)
+				std::memcpy(out, source, count * sizeof(double));
+			return;
+		}
+
+		for(size_t i = 0; i < count; i++)
+			out[i] = source[i] * factor;
+	}
+
+private:
+	std::vector<double> values;
+};
+
+// Structure of arrays vectors of quantities, one QuantityArray per component
+template<typename Q>
+class Vector3TArray
+{
+public:
+	typedef typename Q::UnitType UnitType;
+
+public:
+	void Resize(size_t count)
+	{
+		x.Resize(count);
+		y.Resize(count);
+		z.Resize(count);
+	}
+	size_t Size() const
+	{
+		return x.Size();
+	}
+
+	Vector3T<Q> Get(size_t i) const
+	{
+		return Vector3T<Q>(x.Get(i), y.Get(i), z.Get(i));
+	}
+	void Set(size_t i, const Vector3T<Q>& v)
+	{
+		x.Set(i, v.x);
+		y.Set(i, v.y);
+		z.Set(i, v.z);
+	}
+
+	void Norm(QuantityArray<Q>& out) const
+	{
+		size_t count = Size();
+		out.Resize(count);
+
+		const double* px = x.Data();
+		const double* py = y.Data();
+		const double* pz = z.Data();
+		double* res = out.Data();
+
+		for(size_t i = 0; i < count; i++)
+			res[i] = std::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i]);
+	}
+
+	void ConvertTo(const UnitType& unit, Vec3Array& out) const
+	{
+		out.Resize(Size());
+
+		x.ConvertTo(unit, out.x.data());
+		y.ConvertTo(unit, out.y.data());
+		z.ConvertTo(unit, out.z.data());
+	}
+
+	Vector3TArray& operator+=(const Vector3TArray& rhs)
+	{
+		if(rhs.Size() != Size())
+			CSpiceUtil::SignalError("Vector3TArray::operator+=: element counts differ");
+
+		x += rhs.x;
+		y += rhs.y;
+		z += rhs.z;
+
+		return *this;
+	}
+	Vector3TArray& operator-=(const Vector3TArray& rhs)
+	{
+		if(rhs.Size() != Size())
+			CSpiceUtil::SignalError("Vector3TArray::operator-=: element counts differ");
+
+		x -= rhs.x;
+		y -= rhs.y;
+		z -= rhs.z;
+
+		return *this;
+	}
+	Vector3TArray& operator*=(double rhs)
+	{
+		x *= rhs;
+		y *= rhs;
+		z *= rhs;
+
+		return *this;
+	}
+
+public:
+	QuantityArray<Q> x;
+	QuantityArray<Q> y;
+	QuantityArray<Q> z;
+};
@@ -0,0 +1,94 @@
+#include "Vec3Array.h"
+#include "VectorRotation.h"
+
+#include <cmath>
+
+// Loops are kept free of aliasing and branches so that the compiler can vectorize them
+
+void Vec3Array::Dot(const Vec3Array& a, const Vec3Array& b, std::vector<double>& out)
+{
+	size_t count = a.Size();
+	out.resize(count);
+
+	const double* ax = a.x.data();
+	const double* ay = a.y.data();
+	const double* az = a.z.data();
+	const double* bx = b.x.data();
+	const double* by = b.y.data();
+	const double* bz = b.z.data();
+	double* res = out.data();
+
+	for(size_t i = 0; i < count; i++)
+		res[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+}
+
+void Vec3Array::Cross(const Vec3Array& a, const Vec3Array& b, Vec3Array& out)
+{
+	size_t count = a.Size();
+
+	// Computed into a temporary when out is one of the operands
+	Vec3Array temp;
+	Vec3Array& res = (&out == &a || &out == &b) ? temp : out;
+	res.Resize(count);
+
+	const double* ax = a.x.data();
+	const double* ay = a.y.data();
+	const double* az = a.z.data();
+	const double* bx = b.x.data();
+	const double* by = b.y.data();
+	const double* bz = b.z.data();
+	double* rx = res.x.data();
+	double* ry = res.y.data();
+	double* rz = res.z.data();
+
+	for(size_t i = 0; i < count; i++)
+	{
+		rx[i] = ay[i] * bz[i] - az[i] * by[i];
+		ry[i] = az[i] * bx[i] - ax[i] * bz[i];
+		rz[i] = ax[i] * by[i] - ay[i] * bx[i];
+	}
+
+	if(&res == &temp)
+		out = temp;
+}
+
+void Vec3Array::Norm(const Vec3Array& a, std::vector<double>& out)
+{
+	Dot(a, a, out);
+
+	double* res = out.data();
+
+	for(size_t i = 0; i < out.size(); i++)
+		res[i] = std::sqrt(res[i]);
+}
+
+void Vec3Array::Normalize(Vec3Array& a)
+{
+	std::vector<double> norms;
+	Norm(a, norms);
+
+	double* ax = a.x.data();
+	double* ay = a.y.data();
+	double* az = a.z.data();
+
+	for(size_t i = 0; i < norms.size(); i++)
+	{
+		double scale = (norms[i] > 0.0) ? 1.0 / norms[i] : 1.0;
+
+		ax[i] *= scale;
+		ay[i] *= scale;
+		az[i] *= scale;
+	}
+}
+
+void Vec3Array::Multiply(const Matrix3d& matrix, const Vec3Array& a, Vec3Array& out)
+{
+	out.Resize(a.Size());
+
+	VectorRotation::Rotate(matrix.GetData(), a.x.data(), a.y.data(), a.z.data(), a.Size(), out.x.data(), out.y.data(), out.z.data());
+}
+
+void Vec3Array::TransposeMultiply(const Matrix3d& matrix, const Vec3Array& a, Vec3Array& out)
+{
+	Multiply(matrix.Transposed(), a, out);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Vector3d.h"
+#include "Matrix3d.h"
+
+#include <vector>
+
+// Structure of arrays storage for many double precision vectors, kernels work on the component arrays
+struct Vec3Array
+{
+public:
+	void Resize(size_t count)
+	{
+		x.resize(count);
+		y.resize(count);
+		z.resize(count);
+	}
+
+	size_t Size() const
+	{
+		return x.size();
+	}
+
+	Vector3d Get(size_t i) const
+	{
+		return Vector3d(x[i], y[i], z[i]);
+	}
+	void Set(size_t i, const Vector3d& v)
+	{
+		x[i] = v.x;
+		y[i] = v.y;
+		z[i] = v.z;
+	}
+
+	static void Dot(const Vec3Array& a, const Vec3Array& b, std::vector<double>& out);
+	static void Cross(const Vec3Array& a, const Vec3Array& b, Vec3Array& out);
+	static void Norm(const Vec3Array& a, std::vector<double>& out);
+	static void Normalize(Vec3Array& a);
+
+	// out may be a
+	static void Multiply(const Matrix3d& matrix, const Vec3Array& a, Vec3Array& out);
+	static void TransposeMultiply(const Matrix3d& matrix, const Vec3Array& a, Vec3Array& out);
+
+public:
+	std::vector<double> x;
+	std::vector<double> y;
+	std::vector<double> z;
+};
@@ -1,10 +1,49 @@
 #pragma once
 
 #include <cmath>
+#include <cfloat>
 
+// Base unit value of a vector component, quantities expose it and plain doubles are their own value
+template<typename T>
+struct Vector3TScalar
+{
+	static double ToBase(const T& value)
+	{
+		return value.ValueInBase();
+	}
+	static T FromBase(double value)
+	{
+		return T::FromBase(value);
+	}
+};
+
+template<>
+struct Vector3TScalar<double>
+{
+	static double ToBase(double value)
+	{
+		return value;
+	}
+	static double FromBase(double value)
+	{
+		return value;
+	}
+};
+
+// Component type of dot and cross products, e.g. Length and Velocity give an angular momentum per mass
+template<typename T, typename U>
+struct Vector3TProduct
+{
+	typedef decltype(T() * U()) Type;
+};
+
+// Vector of typed components. Every operation works on the base unit doubles,
+// so typed vectors cost the same as raw ones.
 template<typename T>
 class Vector3T
 {
+	typedef Vector3TScalar<T> Scalar;
+
 public:
 	Vector3T()
 	{
@@ -34,20 +73,72 @@ public:
 
 	T Length() const
 	{
-		double ydivx = y / x;
-		double zdivx = z / x;
+		double bx = Scalar::ToBase(x);
+		double by = Scalar::ToBase(y);
+		double bz = Scalar::ToBase(z);
+
+		double sum = bx * bx + by * by + bz * bz;
+
+		// Squares only overflow or underflow at extreme magnitudes, rescale by the largest component there
+		if(sum > DBL_MIN && sum <= DBL_MAX)
+			return Scalar::FromBase(std::sqrt(sum));
+
+		double scale = std::fabs(bx);
+		if(std::fabs(by) > scale)
+			scale = std::fabs(by);
+		if(std::fabs(bz) > scale)
+			scale = std::fabs(bz);
+
+		if(scale == 0.0 || !(scale <= DBL_MAX))
+			return Scalar::FromBase(scale);
+
+		bx /= scale;
+		by /= scale;
+		bz /= scale;
+
+		return Scalar::FromBase(scale * std::sqrt(bx * bx + by * by + bz * bz));
+	}
+
+	// Unit vector along this one, zero vectors stay zero
+	Vector3T<double> Normalized() const
+	{
+		double length = Scalar::ToBase(Length());
+
+		if(length == 0.0)
+			return Vector3T<double>(0.0, 0.0, 0.0);
+
+		double inv = 1.0 / length;
+
+		return Vector3T<double>(Scalar::ToBase(x) * inv, Scalar::ToBase(y) * inv, Scalar::ToBase(z) * inv);
+	}
+
+	template<typename U>
+	typename Vector3TProduct<T, U>::Type Dot(const Vector3T<U>& rhs) const
+	{
+		typedef Vector3TScalar<U> RhsScalar;
+
+		double res = Scalar::ToBase(x) * RhsScalar::ToBase(rhs.x) + Scalar::ToBase(y) * RhsScalar::ToBase(rhs.y) + Scalar::ToBase(z) * RhsScalar::ToBase(rhs.z);
+
+		return Vector3TScalar<typename Vector3TProduct<T, U>::Type>::FromBase(res);
+	}
+
+	template<typename U>
+	Vector3T<typename Vector3TProduct<T, U>::Type> Cross(const Vector3T<U>& rhs) const
+	{
+		typedef Vector3TScalar<U> RhsScalar;
+		typedef Vector3TScalar<typename Vector3TProduct<T, U>::Type> ResScalar;
 
-		T result = x * std::sqrt(1.0 + ydivx*ydivx + zdivx*zdivx);
+		double ax = Scalar::ToBase(x);
+		double ay = Scalar::ToBase(y);
+		double az = Scalar::ToBase(z);
+		double bx = RhsScalar::ToBase(rhs.x);
+		double by = RhsScalar::ToBase(rhs.y);
+		double bz = RhsScalar::ToBase(rhs.z);
 
-		// TODO: understand how to use abs
-		T zero = T();
-		if(result > zero)
-			return result;
-		else
-			return -result;
+		return Vector3T<typename Vector3TProduct<T, U>::Type>(ResScalar::FromBase(ay * bz - az * by), ResScalar::FromBase(az * bx - ax * bz), ResScalar::FromBase(ax * by - ay * bx));
 	}
 
-	T& operator+=(const Vector3T& rhs)
+	Vector3T& operator+=(const Vector3T& rhs)
 	{
 		x += rhs.x;
 		y += rhs.y;
@@ -55,11 +146,15 @@ public:
 
 		return *this;
 	}
-	T& operator-=(const Vector3T& rhs)
+	Vector3T& operator-=(const Vector3T& rhs)
 	{
-		return (*this += (-rhs));
+		x -= rhs.x;
+		y -= rhs.y;
+		z -= rhs.z;
+
+		return *this;
 	}
-	T& operator*=(double rhs)
+	Vector3T& operator*=(double rhs)
 	{
 		x *= rhs;
 		y *= rhs;
@@ -67,7 +162,7 @@ public:
 
 		return *this;
 	}
-	T& operator/=(double rhs)
+	Vector3T& operator/=(double rhs)
 	{
 		return (*this *= (1.0 / rhs));
 	}
@@ -77,36 +172,28 @@ public:
 	T y;
 	T z;
 
-	friend T operator+(const Vector3T& lhs, const Vector3T& rhs)
+	friend Vector3T operator+(const Vector3T& lhs, const Vector3T& rhs)
 	{
-		T x = lhs.x + rhs.x;
-		T y = lhs.y + rhs.y;
-		T z = lhs.z + rhs.z;
-
-		return Vector3T(x, y, z);
+		return Vector3T(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
 	}
-	friend T operator-(const Vector3T& lhs, const Vector3T& rhs)
+	friend Vector3T operator-(const Vector3T& lhs, const Vector3T& rhs)
 	{
-		return lhs + (-rhs);
+		return Vector3T(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
 	}
-	friend T operator-(const Vector3T& op)
+	friend Vector3T operator-(const Vector3T& op)
 	{
-		return (-1.0) * op;
+		return Vector3T(-op.x, -op.y, -op.z);
 	}
-	friend T operator*(double lhs, const Vector3T& rhs)
+	friend Vector3T operator*(double lhs, const Vector3T& rhs)
 	{
-		T x = lsh * rhs.x;
-		T y = lsh * rhs.y;
-		T z = lsh * rhs.z;
-
-		return Vector3T(x, y, z);
+		return Vector3T(lhs * rhs.x, lhs * rhs.y, lhs * rhs.z);
 	}
-	friend T operator*(const Vector3T& lhs, double rhs)
+	friend Vector3T operator*(const Vector3T& lhs, double rhs)
 	{
 		return rhs * lhs;
 	}
-	friend T operator/(const Vector3T& lhs, double rhs)
+	friend Vector3T operator/(const Vector3T& lhs, double rhs)
 	{
-		return lhs * (1.0)/rhs;
+		return lhs * (1.0 / rhs);
 	}
-};
\ No newline at end of file
+};
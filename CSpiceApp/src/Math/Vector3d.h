@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cmath>
+
+#ifdef _MSC_VER
+#define MATH_ALIGN(n) __declspec(align(n))
+#else
+#define MATH_ALIGN(n) __attribute__((aligned(n)))
+#endif
+
+// Double precision vector padded to 32 bytes so that it fills one AVX register.
+// Aligned types can't be passed by value on 32 bit MSVC, always pass by reference.
+class MATH_ALIGN(32) Vector3d
+{
+public:
+	Vector3d() : x(0.0), y(0.0), z(0.0), w(0.0)
+	{
+
+	}
+	Vector3d(double x, double y, double z) : x(x), y(y), z(z), w(0.0)
+	{
+
+	}
+	explicit Vector3d(const double* pv) : x(pv[0]), y(pv[1]), z(pv[2]), w(0.0)
+	{
+
+	}
+
+	void Set(double x, double y, double z)
+	{
+		this->x = x;
+		this->y = y;
+		this->z = z;
+	}
+	void Assign(const double* pv)
+	{
+		x = pv[0];
+		y = pv[1];
+		z = pv[2];
+	}
+	void CopyTo(double* pv) const
+	{
+		pv[0] = x;
+		pv[1] = y;
+		pv[2] = z;
+	}
+
+	double Dot(const Vector3d& rhs) const
+	{
+		return x * rhs.x + y * rhs.y + z * rhs.z;
+	}
+	Vector3d Cross(const Vector3d& rhs) const
+	{
+		return Vector3d(y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x);
+	}
+	double Length() const
+	{
+		return std::sqrt(Dot(*this));
+	}
+	Vector3d Normalized() const
+	{
+		double length = Length();
+
+		return (length > 0.0) ? (*this * (1.0 / length)) : *this;
+	}
+
+	double operator[](size_t i) const
+	{
+		return (&x)[i];
+	}
+	double& operator[](size_t i)
+	{
+		return (&x)[i];
+	}
+
+	Vector3d& operator+=(const Vector3d& rhs)
+	{
+		x += rhs.x;
+		y += rhs.y;
+		z += rhs.z;
+
+		return *this;
+	}
+	Vector3d& operator-=(const Vector3d& rhs)
+	{
+		x -= rhs.x;
+		y -= rhs.y;
+		z -= rhs.z;
+
+		return *this;
+	}
+	Vector3d& operator*=(double rhs)
+	{
+		x *= rhs;
+		y *= rhs;
+		z *= rhs;
+
+		return *this;
+	}
+
+	Vector3d operator+(const Vector3d& rhs) const
+	{
+		return Vector3d(x + rhs.x, y + rhs.y, z + rhs.z);
+	}
+	Vector3d operator-(const Vector3d& rhs) const
+	{
+		return Vector3d(x - rhs.x, y - rhs.y, z - rhs.z);
+	}
+	Vector3d operator-() const
+	{
+		return Vector3d(-x, -y, -z);
+	}
+	Vector3d operator*(double rhs) const
+	{
+		return Vector3d(x * rhs, y * rhs, z * rhs);
+	}
+
+public:
+	double x;
+	double y;
+	double z;
+
+private:
+	double w; // padding
+};
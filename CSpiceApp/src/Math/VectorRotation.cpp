@@ -0,0 +1,172 @@
+#include "VectorRotation.h"
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define VECTOR_ROTATION_AVX_TARGET
+#else
+#define VECTOR_ROTATION_AVX_TARGET __attribute__((target("avx")))
+#endif
+
+// Every path evaluates (r0 * x + r1 * y) + r2 * z with separate multiplies and adds,
+// so results don't depend on the instruction set in use
+
+#if !defined(__AVX512F__)
+static bool DetectAvx()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+
+	// AVX on the CPU and YMM state saved by the OS
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+
+	return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+	return __builtin_cpu_supports("avx") != 0;
+#endif
+}
+
+static const bool avxSupported = DetectAvx();
+
+VECTOR_ROTATION_AVX_TARGET static size_t RotateAvx(const double rotation[3][3], const double* x, const double* y, const double* z, size_t count, double* outX, double* outY, double* outZ)
+{
+	__m256d r[3][3];
+	for(int row = 0; row < 3; row++)
+	{
+		for(int col = 0; col < 3; col++)
+			r[row][col] = _mm256_set1_pd(rotation[row][col]);
+	}
+
+	size_t i = 0;
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m256d vx = _mm256_loadu_pd(x + i);
+		__m256d vy = _mm256_loadu_pd(y + i);
+		__m256d vz = _mm256_loadu_pd(z + i);
+
+		_mm256_storeu_pd(outX + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r[0][0], vx), _mm256_mul_pd(r[0][1], vy)), _mm256_mul_pd(r[0][2], vz)));
+		_mm256_storeu_pd(outY + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r[1][0], vx), _mm256_mul_pd(r[1][1], vy)), _mm256_mul_pd(r[1][2], vz)));
+		_mm256_storeu_pd(outZ + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(r[2][0], vx), _mm256_mul_pd(r[2][1], vy)), _mm256_mul_pd(r[2][2], vz)));
+	}
+
+	_mm256_zeroupper();
+
+	return i;
+}
+
+VECTOR_ROTATION_AVX_TARGET static size_t RotateAvx(const double* const r[9], const double* x, const double* y, const double* z, size_t count, double* outX, double* outY, double* outZ)
+{
+	size_t i = 0;
+
+	for(; i + 4 <= count; i += 4)
+	{
+		__m256d vx = _mm256_loadu_pd(x + i);
+		__m256d vy = _mm256_loadu_pd(y + i);
+		__m256d vz = _mm256_loadu_pd(z + i);
+
+		__m256d rx = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(r[0] + i), vx), _mm256_mul_pd(_mm256_loadu_pd(r[1] + i), vy)), _mm256_mul_pd(_mm256_loadu_pd(r[2] + i), vz));
+		__m256d ry = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(r[3] + i), vx), _mm256_mul_pd(_mm256_loadu_pd(r[4] + i), vy)), _mm256_mul_pd(_mm256_loadu_pd(r[5] + i), vz));
+		__m256d rz = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(r[6] + i), vx), _mm256_mul_pd(_mm256_loadu_pd(r[7] + i), vy)), _mm256_mul_pd(_mm256_loadu_pd(r[8] + i), vz));
+
+		_mm256_storeu_pd(outX + i, rx);
+		_mm256_storeu_pd(outY + i, ry);
+		_mm256_storeu_pd(outZ + i, rz);
+	}
+
+	_mm256_zeroupper();
+
+	return i;
+}
+#endif
+
+void VectorRotation::Rotate(const double rotation[3][3], const double* x, const double* y, const double* z, size_t count, double* outX, double* outY, double* outZ)
+{
+	size_t i = 0;
+
+#if defined(__AVX512F__)
+	__m512d r[3][3];
+	for(int row = 0; row < 3; row++)
+	{
+		for(int col = 0; col < 3; col++)
+			r[row][col] = _mm512_set1_pd(rotation[row][col]);
+	}
+
+	for(; i + 8 <= count; i += 8)
+	{
+		__m512d vx = _mm512_loadu_pd(x + i);
+		__m512d vy = _mm512_loadu_pd(y + i);
+		__m512d vz = _mm512_loadu_pd(z + i);
+
+		_mm512_storeu_pd(outX + i, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(r[0][0], vx), _mm512_mul_pd(r[0][1], vy)), _mm512_mul_pd(r[0][2], vz)));
+		_mm512_storeu_pd(outY + i, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(r[1][0], vx), _mm512_mul_pd(r[1][1], vy)), _mm512_mul_pd(r[1][2], vz)));
+		_mm512_storeu_pd(outZ + i, _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(r[2][0], vx), _mm512_mul_pd(r[2][1], vy)), _mm512_mul_pd(r[2][2], vz)));
+	}
+#else
+	if(avxSupported)
+		i = RotateAvx(rotation, x, y, z, count, outX, outY, outZ);
+#endif
+
+	const double r00 = rotation[0][0], r01 = rotation[0][1], r02 = rotation[0][2];
+	const double r10 = rotation[1][0], r11 = rotation[1][1], r12 = rotation[1][2];
+	const double r20 = rotation[2][0], r21 = rotation[2][1], r22 = rotation[2][2];
+
+	for(; i < count; i++)
+	{
+		double vx = x[i], vy = y[i], vz = z[i];
+
+		outX[i] = r00 * vx + r01 * vy + r02 * vz;
+		outY[i] = r10 * vx + r11 * vy + r12 * vz;
+		outZ[i] = r20 * vx + r21 * vy + r22 * vz;
+	}
+}
+
+void VectorRotation::Rotate(const double* rotations, const double* x, const double* y, const double* z, size_t count, double* outX, double* outY, double* outZ)
+{
+	const double* r[9];
+	for(int k = 0; k < 9; k++)
+		r[k] = rotations + k * count;
+
+	size_t i = 0;
+
+#if defined(__AVX512F__)
+	for(; i + 8 <= count; i += 8)
+	{
+		__m512d vx = _mm512_loadu_pd(x + i);
+		__m512d vy = _mm512_loadu_pd(y + i);
+		__m512d vz = _mm512_loadu_pd(z + i);
+
+		__m512d rx = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(r[0] + i), vx), _mm512_mul_pd(_mm512_loadu_pd(r[1] + i), vy)), _mm512_mul_pd(_mm512_loadu_pd(r[2] + i), vz));
+		__m512d ry = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(r[3] + i), vx), _mm512_mul_pd(_mm512_loadu_pd(r[4] + i), vy)), _mm512_mul_pd(_mm512_loadu_pd(r[5] + i), vz));
+		__m512d rz = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_loadu_pd(r[6] + i), vx), _mm512_mul_pd(_mm512_loadu_pd(r[7] + i), vy)), _mm512_mul_pd(_mm512_loadu_pd(r[8] + i), vz));
+
+		_mm512_storeu_pd(outX + i, rx);
+		_mm512_storeu_pd(outY + i, ry);
+		_mm512_storeu_pd(outZ + i, rz);
+	}
+#else
+	if(avxSupported)
+		i = RotateAvx(r, x, y, z, count, outX, outY, outZ);
+#endif
+
+	for(; i < count; i++)
+	{
+		double vx = x[i], vy = y[i], vz = z[i];
+
+		outX[i] = r[0][i] * vx + r[1][i] * vy + r[2][i] * vz;
+		outY[i] = r[3][i] * vx + r[4][i] * vy + r[5][i] * vz;
+		outZ[i] = r[6][i] * vx + r[7][i] * vy + r[8][i] * vz;
+	}
+}
+
+const char* VectorRotation::GetInstructionSet()
+{
+#if defined(__AVX512F__)
+	return "AVX-512";
+#else
+	return avxSupported ? "AVX" : "Scalar";
+#endif
+}
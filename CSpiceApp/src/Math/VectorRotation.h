@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+// Rotation of many vectors stored as separate x, y, z arrays.
+// Uses AVX-512 when the translation unit is compiled for it, otherwise AVX when the CPU supports it at run time, scalar code as a last resort.
+// Output arrays may be the input ones.
+class VectorRotation
+{
+public:
+	// Same matrix for every vector
+	static void Rotate(const double rotation[3][3], const double* x, const double* y, const double* z, size_t count, double* outX, double* outY, double* outZ);
+
+	// One matrix per vector, element (row, col) of matrix i is at rotations[(3 * row + col) * count + i]
+	static void Rotate(const double* rotations, const double* x, const double* y, const double* z, size_t count, double* outX, double* outY, double* outZ);
+
+	static const char* GetInstructionSet();
+};